@@ -25,5 +25,10 @@ namespace lv {
         constexpr float MAX_FRAME_TIME = 0.25f; // Max dt to avoid spiral of death
 
         constexpr float PATHFINDING_UPDATE_INTERVAL = 0.33f; // Time in seconds between pathfinding updates
+        constexpr unsigned PATHFINDING_WORKER_COUNT = 2; // Threads that run queued path searches off the main thread
+        constexpr int PATHFINDING_NODES_PER_TICK = 4000; // Most nodes all path searches together may expand in one fixed update
+        constexpr int PATHFINDING_NODES_PER_SEARCH = 500; // Most nodes a single search may expand in one fixed update
+        constexpr int PATHFINDING_LANDMARK_COUNT = 8; // Landmarks in the table behind Pathfinding::Algorithm::AStarLandmarks
+        constexpr int REGION_REFINE_TILES_PER_TICK = 32768; // Most tiles relabelled per fixed update after a large split, see CollisionGrid::refineRegions()
     }
 }
\ No newline at end of file
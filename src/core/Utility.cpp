@@ -8,13 +8,32 @@
 // ================================================================================================
 
 #include <map>
+#include <array>
 #include <random>
 #include <cmath>
+#include <limits>
+#include <algorithm>
 #include <SFML/Graphics/VertexArray.hpp>
 #include <SFML/Graphics/ConvexShape.hpp>
 #include "Utility.hpp"
 #include "../world/TileMap.hpp"
 
+namespace
+{
+	// True if a box of `size` centred on `center` is inside the map and overlaps no solid tile
+	bool isHitboxClear(sf::Vector2f center, sf::Vector2f size, const TileMap& tileMap)
+	{
+		sf::FloatRect hitbox(center - size / 2.f, size);
+
+		// Convert hitbox bounds to tile range
+		sf::IntRect tileRange = TileMap::getOverlappedTiles(hitbox);
+		if (!tileMap.isWithinBounds(tileRange.position) || !tileMap.isWithinBounds(tileRange.position + tileRange.size - sf::Vector2i(1, 1)))
+			return false;
+
+		return !tileMap.anySolidInRect(tileRange);
+	}
+}
+
 bool Utility::isKeyReleased(sf::Keyboard::Key key)
 {
 	static std::map<sf::Keyboard::Key, bool> keyStates;
@@ -210,47 +229,53 @@ sf::Vector2f Utility::normalize(sf::Vector2f vector)
 bool Utility::hasLineOfSight(sf::Vector2f from, sf::Vector2f to, const TileMap& tileMap)
 {
 	sf::Vector2f delta = to - from;
-	float distance = std::hypotf(delta.x, delta.y);
-	if (distance < 1.f)
+	if (std::hypotf(delta.x, delta.y) < 1.f)
 		return true; // Too close to check, assume line of sight
 
-	sf::Vector2f direction = delta / distance;
-	float stepSize = TileMap::TILE_SIZE / 2.f; // Check every half tile
-	sf::Vector2f currentPosition = from;
-
-	float traveled = 0.f;
-	sf::Vector2i lastTile = worldToTileCoords(from);
-
-	while (traveled < distance)
+	// Amanatides-Woo traversal: visits every tile the segment crosses once, in order.
+	// `nextX` and `nextY` are how far along the segment (0 to 1) it leaves the current column and
+	//  row, and `deltaX` and `deltaY` how far it takes to cross a whole column and row.
+	const float tileSize = static_cast<float>(TileMap::TILE_SIZE);
+	sf::Vector2i tile(static_cast<int>(std::floor(from.x / tileSize)), static_cast<int>(std::floor(from.y / tileSize)));
+	const sf::Vector2i lastTile(static_cast<int>(std::floor(to.x / tileSize)), static_cast<int>(std::floor(to.y / tileSize)));
+	const int stepX = delta.x > 0.f ? 1 : -1;
+	const int stepY = delta.y > 0.f ? 1 : -1;
+
+	const float infinity = std::numeric_limits<float>::infinity();
+	const float deltaX = delta.x != 0.f ? tileSize / std::fabs(delta.x) : infinity;
+	const float deltaY = delta.y != 0.f ? tileSize / std::fabs(delta.y) : infinity;
+	float nextX = delta.x != 0.f ? ((stepX > 0 ? tile.x + 1 : tile.x) * tileSize - from.x) / delta.x : infinity;
+	float nextY = delta.y != 0.f ? ((stepY > 0 ? tile.y + 1 : tile.y) * tileSize - from.y) / delta.y : infinity;
+
+	while (tile != lastTile)
 	{
-		currentPosition += direction * stepSize;
-		traveled += stepSize;
+		// Rounding can make one axis look like it is ahead when that axis has already arrived
+		bool canStepX = tile.x != lastTile.x;
+		bool canStepY = tile.y != lastTile.y;
 
-		sf::Vector2i currentTile = worldToTileCoords(currentPosition);
-		if (!tileMap.isWithinBounds(currentTile))
-			return false;
-
-		// Solid tile hit
-		if (tileMap.getTile(currentTile).type == Tile::Type::Solid)
-			return false;
-
-		// Check for diagonal corner clipping
-		int dx = currentTile.x - lastTile.x;
-		int dy = currentTile.y - lastTile.y;
-
-		if (dx != 0 && dy != 0) // Diagonal movement
+		if (canStepX && canStepY && nextX == nextY)
 		{
-			sf::Vector2i side1(lastTile.x + dx, lastTile.y); // horizontal neighbor
-			sf::Vector2i side2(lastTile.x, lastTile.y + dy); // vertical neighbor
-
-			if ((tileMap.isWithinBounds(side1) && tileMap.getTile(side1).type == Tile::Type::Solid) &&
-				(tileMap.isWithinBounds(side2) && tileMap.getTile(side2).type == Tile::Type::Solid))
-			{
-				return false; // Block LOS through corner
-			}
+			// Exactly through a corner: blocked only if both tiles beside it are solid
+			if (tileMap.isSolid(tile.x + stepX, tile.y) && tileMap.isSolid(tile.x, tile.y + stepY))
+				return false;
+			tile.x += stepX;
+			tile.y += stepY;
+			nextX += deltaX;
+			nextY += deltaY;
+		}
+		else if (canStepX && (!canStepY || nextX < nextY))
+		{
+			tile.x += stepX;
+			nextX += deltaX;
+		}
+		else
+		{
+			tile.y += stepY;
+			nextY += deltaY;
 		}
 
-		lastTile = currentTile;
+		if (!tileMap.isWithinBounds(tile) || tileMap.isSolid(tile.x, tile.y))
+			return false;
 	}
 
 	return true;
@@ -258,13 +283,22 @@ bool Utility::hasLineOfSight(sf::Vector2f from, sf::Vector2f to, const TileMap&
 
 bool Utility::hasLineOfSight(sf::Vector2f from, sf::FloatRect to, const TileMap& tileMap)
 {
-	std::vector<sf::Vector2f> corners =
-	{
+	// Every ray to a corner stays inside the box around `from` and the rectangle, so if that box
+	//  is clear none of them has to be traced
+	sf::Vector2f boxMin(std::min(from.x, to.position.x), std::min(from.y, to.position.y));
+	sf::Vector2f boxMax(std::max(from.x, to.position.x + to.size.x), std::max(from.y, to.position.y + to.size.y));
+	sf::IntRect box = TileMap::getOverlappedTiles(sf::FloatRect(boxMin, boxMax - boxMin));
+	if (tileMap.isWithinBounds(box.position) && tileMap.isWithinBounds(box.position + box.size - sf::Vector2i(1, 1)) &&
+		!tileMap.anySolidInRect(box))
+		return true;
+
+	const std::array<sf::Vector2f, 4> corners =
+	{ {
 		{to.position.x, to.position.y},
 		{to.position.x + to.size.x, to.position.y},
 		{to.position.x, to.position.y + to.size.y},
 		{to.position.x + to.size.x, to.position.y + to.size.y}
-	};
+	} };
 
 	for (const auto& corner : corners)
 		if (hasLineOfSight(from, corner, tileMap))
@@ -283,30 +317,16 @@ bool Utility::hasLineOfSightWithClearance(sf::Vector2f from, sf::Vector2f to, sf
 	sf::Vector2f direction = delta / distance;
 	float stepSize = TileMap::TILE_SIZE / 3.f;
 	float traveled = 0.f;
+	// A step whose tile has this much clearance can't touch anything solid or leave the map
+	const int requiredClearance = TileMap::getRequiredClearance(size);
 
 	while (traveled < distance)
 	{
 		sf::Vector2f currentPosition = from + direction * traveled;
-		sf::FloatRect hitbox(currentPosition - size / 2.f, size);
-
-		// Convert hitbox bounds to tile range
-		int left = static_cast<int>(std::floor(hitbox.position.x / TileMap::TILE_SIZE));
-		int top = static_cast<int>(std::floor(hitbox.position.y / TileMap::TILE_SIZE));
-		int right = static_cast<int>(std::floor((hitbox.position.x + hitbox.size.x) / TileMap::TILE_SIZE));
-		int bottom = static_cast<int>(std::floor((hitbox.position.y + hitbox.size.y) / TileMap::TILE_SIZE));
-
-		for (int y = top; y <= bottom; ++y)
-		{
-			for (int x = left; x <= right; ++x)
-			{
-				sf::Vector2i tilePos(x, y);
-				if (!tileMap.isWithinBounds(tilePos))
-					return false;
-
-				if (tileMap.getTile(tilePos).type == Tile::Type::Solid)
-					return false;
-			}
-		}
+		sf::Vector2i currentTile(static_cast<int>(std::floor(currentPosition.x / TileMap::TILE_SIZE)),
+		                         static_cast<int>(std::floor(currentPosition.y / TileMap::TILE_SIZE)));
+		if (tileMap.getClearance(currentTile) < requiredClearance && !isHitboxClear(currentPosition, size, tileMap))
+			return false;
 
 		traveled += stepSize;
 	}
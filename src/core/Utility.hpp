@@ -74,9 +74,13 @@ namespace Utility
 	//bool doesRectIntersectPolygon(sf::FloatRect rect, std::vector<sf::Vector2f> polygon);
 
 	// Check if there is a line of sight between two points, considering tile collisions.
+	// Every tile the segment crosses is checked exactly once. A segment running exactly through a
+	//  corner is only blocked there if both tiles beside the corner are solid.
 	bool hasLineOfSight(sf::Vector2f from, sf::Vector2f to, const TileMap& tileMap);
 
 	// Check if there is a line of sight from a point to any corner of a rectangle.
+	// If no tile in the box around the point and the rectangle is solid, every corner is visible and
+	//  nothing is traced; otherwise each corner's ray is traced on its own until one is clear.
 	bool hasLineOfSight(sf::Vector2f from, sf::FloatRect to, const TileMap& tileMap);
 
 	// Check if there is a line of sight between two points, considering tile collisions and a clearance size.
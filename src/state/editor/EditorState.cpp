@@ -79,8 +79,10 @@ EditorState::EditorState(StateManager& stateManager, PlayState& playState, World
 	mapLoadedText.setOutlineColor(sf::Color(30, 30, 30, 255));
 	mapLoadedText.setOutlineThickness(2.f);
 
+	Navigation& navigation = world.getCurrentArea().navigation;
+	navigation.updatePlayerVisibility(world.getCurrentArea().map, Utility::worldToTileCoords(player.getLogicPositionCenter()));
 	for (auto& enemy : enemies)
-		enemy->updateDebugVisuals(world.getCurrentArea().map, player.getBounds());
+		enemy->updateDebugVisuals(world.getCurrentArea().map, navigation, player);
 }
 
 void EditorState::processInput(const sf::RenderWindow& window, const std::vector<sf::Event>& events)
@@ -639,6 +641,8 @@ void EditorState::applySelectionAction()
 	else
 		newType = palette.at(selectedTileIndex);
 
+	// The whole rectangle is one edit, so the collision data is updated once rather than per tile
+	world.getCurrentArea().map.beginEdit();
 	for (int y = topLeft.y; y <= bottomRight.y; ++y)
 	{
 		for (int x = topLeft.x; x <= bottomRight.x; ++x)
@@ -656,7 +660,7 @@ void EditorState::applySelectionAction()
 					if (oldType == newType)
 						continue;
 					batch.push_back(std::make_unique<TileAction>(sf::Vector2i(x, y), oldType, newType));
-					world.getCurrentArea().map.setTile(x, y, Tile{ newType }, false);
+					world.getCurrentArea().map.setTile(x, y, Tile{ newType });
 					break;
 				default:
 					break;
@@ -668,7 +672,7 @@ void EditorState::applySelectionAction()
 				{
 				case Mode::TILES:
 					batch.push_back(std::make_unique<TileAction>(sf::Vector2i(x, y), oldType, Tile::Type::EMPTY));
-					world.getCurrentArea().map.setTile(x, y, Tile{ Tile::Type::EMPTY }, false);
+					world.getCurrentArea().map.setTile(x, y, Tile{ Tile::Type::EMPTY });
 					break;
 				default:
 					break;
@@ -677,11 +681,11 @@ void EditorState::applySelectionAction()
 			else if (selectionAction == SelectionAction::ERASE_ALL)
 			{
 				batch.push_back(std::make_unique<TileAction>(sf::Vector2i(x, y), oldType, Tile::Type::EMPTY));
-				world.getCurrentArea().map.setTile(x, y, Tile{ Tile::Type::EMPTY }, false);
+				world.getCurrentArea().map.setTile(x, y, Tile{ Tile::Type::EMPTY });
 			}
 		}
 	}
-	world.getCurrentArea().map.rebuildVisuals();
+	world.getCurrentArea().map.endEdit();
 
 	if (!batch.empty())
 	{
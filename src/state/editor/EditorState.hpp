@@ -166,12 +166,16 @@ struct BatchAction : public Action
 	{}
 	inline void undo(TileMap& map) override
 	{
+		map.beginEdit();
 		for (auto it = actions.rbegin(); it != actions.rend(); ++it)
 			(*it)->undo(map);
+		map.endEdit();
 	}
 	inline void redo(TileMap& map) override
 	{
+		map.beginEdit();
 		for (auto& action : actions)
 			action->redo(map);
+		map.endEdit();
 	}
 };
\ No newline at end of file
@@ -85,8 +85,12 @@ void PlayState::update(float fixedTimeStep)
 		world.getCurrentArea().enemies.end()
 	);
 
+	world.getCurrentArea().map.refineRegions(lv::Constants::REGION_REFINE_TILES_PER_TICK);
+	world.getCurrentArea().navigation.update(world.getCurrentArea().map, Utility::worldToTileCoords(player.getLogicPosition()), lv::Constants::PATHFINDING_NODES_PER_TICK);
+	world.getCurrentArea().navigation.updatePlayerVisibility(world.getCurrentArea().map, Utility::worldToTileCoords(player.getLogicPositionCenter()));
 	for (auto& enemy : world.getCurrentArea().enemies)
-		enemy->update(fixedTimeStep, world.getCurrentArea().map, player);
+		enemy->update(fixedTimeStep, world.getCurrentArea().map, world.getCurrentArea().navigation, player);
+	world.getCurrentArea().navigation.runSearches();
 
 
 	camera.update(fixedTimeStep, player);
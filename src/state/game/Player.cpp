@@ -11,6 +11,7 @@
 
 #include <algorithm>
 #include <iostream>
+#include <cmath>
 #include "Player.hpp"
 #include "../../core/Utility.hpp"
 
@@ -201,8 +202,11 @@ void Player::resolveCollisions(float fixedTimeStep, const TileMap& tileMap)
 	sf::Vector2f verticalFuturePos = { currentPosition.x, currentPosition.y + velocity.y * fixedTimeStep };
 	sf::FloatRect verticalBounds(verticalFuturePos, currentSize);
 
+	// Skip the per-tile checks when there are no solid tiles anywhere near the bounds
+	bool isVerticalNearSolid = tileMap.anySolidInRect(TileMap::getOverlappedTiles(verticalBounds, 1));
+
 	for (int x = (int)(verticalBounds.position.x) / TileMap::TILE_SIZE - 1;
-		x <= (int)(verticalBounds.position.x + verticalBounds.size.x) / TileMap::TILE_SIZE + 1;
+		isVerticalNearSolid && x <= (int)(verticalBounds.position.x + verticalBounds.size.x) / TileMap::TILE_SIZE + 1;
 		++x)
 	{
 		for (int y = (int)(verticalBounds.position.y) / TileMap::TILE_SIZE - 1;
@@ -243,8 +247,11 @@ void Player::resolveCollisions(float fixedTimeStep, const TileMap& tileMap)
 	sf::Vector2f horizontalFuturePos = { currentPosition.x + velocity.x * fixedTimeStep, futurePosition.y };
 	sf::FloatRect horizontalBounds(horizontalFuturePos, currentSize);
 
+	// Skip the per-tile checks when there are no solid tiles anywhere near the bounds
+	bool isHorizontalNearSolid = tileMap.anySolidInRect(TileMap::getOverlappedTiles(horizontalBounds, 1));
+
 	for (int x = (int)(horizontalBounds.position.x) / TileMap::TILE_SIZE - 1;
-		x <= (int)(horizontalBounds.position.x + horizontalBounds.size.x) / TileMap::TILE_SIZE + 1;
+		isHorizontalNearSolid && x <= (int)(horizontalBounds.position.x + horizontalBounds.size.x) / TileMap::TILE_SIZE + 1;
 		++x)
 	{
 		for (int y = (int)(horizontalBounds.position.y) / TileMap::TILE_SIZE - 1;
@@ -298,32 +305,14 @@ bool Player::canStandUp(const TileMap& tileMap) const
 		sf::Vector2f(currentPosition.x,	currentPosition.y - heightDifference), // space above current head
 		sf::Vector2f(currentSize.x, heightDifference)); // height to test
 
-	// Iterate over tiles overlapping that region
-	for (int x = (int)(headCheckBounds.position.x) / TileMap::TILE_SIZE - 1;
-		x <= (int)(headCheckBounds.position.x + headCheckBounds.size.x) / TileMap::TILE_SIZE + 1;
-		++x)
-	{
-		for (int y = (int)(headCheckBounds.position.y) / TileMap::TILE_SIZE - 1;
-			y <= (int)(headCheckBounds.position.y + headCheckBounds.size.y) / TileMap::TILE_SIZE + 1;
-			++y)
-		{
-			sf::Vector2i tileCoords(x, y);
-
-			if (!tileMap.isWithinBounds(tileCoords))
-				continue;
-
-			if (tileMap.getTile(tileCoords).type != Tile::Type::Solid)
-				continue;
-
-			sf::FloatRect tileBounds(
-				sf::Vector2f(tileCoords.x * TileMap::TILE_SIZE, tileCoords.y * TileMap::TILE_SIZE),
-				sf::Vector2f(TileMap::TILE_SIZE, TileMap::TILE_SIZE));
+	// Any solid tile overlapping that region (touching edges doesn't count) blocks standing up
+	int left = static_cast<int>(std::floor(headCheckBounds.position.x / TileMap::TILE_SIZE));
+	int top = static_cast<int>(std::floor(headCheckBounds.position.y / TileMap::TILE_SIZE));
+	int right = static_cast<int>(std::ceil((headCheckBounds.position.x + headCheckBounds.size.x) / TileMap::TILE_SIZE)) - 1;
+	int bottom = static_cast<int>(std::ceil((headCheckBounds.position.y + headCheckBounds.size.y) / TileMap::TILE_SIZE)) - 1;
 
-			auto intersection = headCheckBounds.findIntersection(tileBounds);
-			if (intersection.has_value())
-				return false; // Blocked from standing up
-		}
-	}
+	if (tileMap.anySolidInRect(sf::IntRect({ left, top }, { right - left + 1, bottom - top + 1 })))
+		return false; // Blocked from standing up
 
 	return true; // All clear to grow
 }
\ No newline at end of file
@@ -7,32 +7,41 @@
 // Copyright (c) 2025 Luka Vukorepa
 // ================================================================================================
 
+#include <cmath>
+#include <array>
+#include <algorithm>
 #include <SFML/Graphics/Text.hpp>
 #include "Enemy.hpp"
 #include "../../../core/Time.hpp"
 #include "../../../world/Pathfinding.hpp"
+#include "../../../world/Navigation.hpp"
 #include "../Player.hpp"
 
 using lv::Enemy;
 
 lv::Enemy::Enemy() :
 	state(State::Patrolling),
-	timeSinceLastPathUpdate(0.f),
-	timeSinceGainedLOS(0.f),
-	timeSinceLostLOS(0.f),
 	health(0),
-	patrolSpeed(0.f),
-	chaseSpeed(0.f),
 	aggroRange(0.f),
 	followRange(0.f),
-	currentPatrolIndex(0),
-	isCompleted(false),
-	maxJumpHeight(0.f),
-	maxJumpDistance(0.f),
-	jumpForce(0.f),
-	isOnGround(false),
 	size(0.f, 0.f),
 	color(sf::Color::White),
+	chaseSpeed(0.f),
+	patrolSpeed(0.f),
+	isOnGround(false),
+	jumpForce(0.f),
+	maxJumpHeight(0.f),
+	maxJumpDistance(0.f),
+	timeSinceGainedLOS(0.f),
+	timeSinceLostLOS(0.f),
+	currentPatrolIndex(0),
+	isFollowingPatrolLeg(false),
+	isCompleted(false),
+	isFollowingTrail(false),
+	trailRevision(0),
+	pathfindingAlgorithm(Pathfinding::Algorithm::AStar),
+	isPathSmoothed(false),
+	timeSinceLastPathUpdate(0.f),
 	isSelected(false)
 {}
 
@@ -54,9 +63,16 @@ void Enemy::deserialize(const json& j)
 	isCompleted = true;
 }
 
-bool lv::Enemy::canSeePlayer(const Player& player) const
+bool lv::Enemy::canSeePlayer(const TileMap& tileMap, const Navigation& navigation, const Player& player) const
 {
-	return false;
+	sf::Vector2f eye = getEyePosition();
+	sf::Vector2f playerCenter = player.getLogicPositionCenter();
+	if (std::hypotf(playerCenter.x - eye.x, playerCenter.y - eye.y) >= aggroRange)
+		return false;
+
+	if (!navigation.canSeePlayerFrom(Utility::worldToTileCoords(eye)))
+		return false;
+	return Utility::hasLineOfSight(eye, player.getBounds(), tileMap);
 }
 
 void Enemy::addPatrolPosition(sf::Vector2i tilePosition)
@@ -166,27 +182,28 @@ void Enemy::targetNextPatrolPosition()
 	currentPatrolIndex = getNextPatrolIndex();
 }
 
-void Enemy::updateMovement(const TileMap& tileMap, const Player& player, float fixedTimeStep)
+void Enemy::updateMovement(const TileMap& tileMap, Navigation& navigation, const Player& player, float fixedTimeStep)
 {
 	timeSinceLastPathUpdate += fixedTimeStep;
+	collectPendingPath(navigation);
 
 	switch (state)
 	{
 	case State::Chasing:
-		handleChasing(tileMap, player, fixedTimeStep);
+		handleChasing(tileMap, navigation, player, fixedTimeStep);
 		break;
 
 	case State::Returning:
-		handleReturning(tileMap, fixedTimeStep);
+		handleReturning(tileMap, navigation, fixedTimeStep);
 		break;
 
 	case State::Patrolling:
-		handlePatrolling(tileMap, player, fixedTimeStep);
+		handlePatrolling(tileMap, navigation, player, fixedTimeStep);
 		break;
 	}
 }
 
-void Enemy::handlePatrolling(const TileMap& tileMap, const Player& player, float fixedTimeStep)
+void Enemy::handlePatrolling(const TileMap& tileMap, Navigation& navigation, const Player& player, float fixedTimeStep)
 {
 	using lv::Constants::PATHFINDING_UPDATE_INTERVAL;
 
@@ -194,23 +211,41 @@ void Enemy::handlePatrolling(const TileMap& tileMap, const Player& player, float
 	sf::Vector2f target = getPathTargetPosition(getCurrentPatrolTarget());
 
 	float distToPatrolTarget = std::hypotf(target.x - navPos.x, target.y - navPos.y);
-	float distToPlayer = std::hypotf(player.getLogicPositionCenter().x - navPos.x, player.getLogicPositionCenter().y - navPos.y);
 
-	if (distToPatrolTarget <= patrolSpeed * fixedTimeStep)
+	// The legs are only searched again (on the workers) when the route or the map around them
+	//  changes, a leg being followed that was dropped for that is left until the next patrol position
+	if (patrolRoute.update(tileMap, navigation, patrolPositions, pathfindingAlgorithm, getPathClearance(), getSmoothingClearance()) &&
+		isFollowingPatrolLeg)
+	{
+		clearPath();
+		isFollowingPatrolLeg = false;
+	}
+
+	// A leg ends on the patrol target, but `followPath()` stops within PATH_TOLERANCE of it
+	bool isLegFinished = isFollowingPatrolLeg && currentPathIndex >= path.size();
+	if (distToPatrolTarget <= patrolSpeed * fixedTimeStep || isLegFinished)
 	{
+		std::size_t reachedIndex = currentPatrolIndex;
 		targetNextPatrolPosition();
+		isFollowingPatrolLeg = startPatrolLeg(reachedIndex);
 	}
 
-	if (distToPlayer < aggroRange && Utility::hasLineOfSight(navPos, player.getBounds(), tileMap))
+	if (canSeePlayer(tileMap, navigation, player))
 	{
 		positionBeforeAggro = navPos;
 		d_positionBeforeAggroCircle.setPosition(positionBeforeAggro - sf::Vector2f(d_positionBeforeAggroCircle.getRadius(), d_positionBeforeAggroCircle.getRadius()));
 		state = State::Chasing;
+		isFollowingPatrolLeg = false;
+		chaseTrail.clear();
+		chaseTrail.record(tileMap.getCollisionGrid(), getTilePosition(), getTrailClearance());
 		return;
 	}
+	else if (isFollowingPatrolLeg)
+	{
+		followPath(fixedTimeStep);
+	}
 	else
 	{
-		//if (Utility::hasLineOfSight(center, currentPatrolTargetPixels, tileMap))
 		if (Utility::hasLineOfSightWithClearance(navPos, target, size, tileMap))
 			timeSinceGainedLOS += fixedTimeStep;
 		else
@@ -218,14 +253,14 @@ void Enemy::handlePatrolling(const TileMap& tileMap, const Player& player, float
 
 		if (timeSinceGainedLOS >= LOS_GAINED_THRESHOLD)
 		{
-			path.clear();
+			clearPath();
 			moveTowards(target, fixedTimeStep);
 		}
 		else
 		{
 			if (timeSinceLastPathUpdate >= PATHFINDING_UPDATE_INTERVAL)
 			{
-				recalculatePath(tileMap, Utility::worldToTileCoords(target));
+				recalculatePath(navigation, Utility::worldToTileCoords(target));
 				timeSinceLastPathUpdate = 0.f;
 			}
 			followPath(fixedTimeStep);
@@ -233,14 +268,15 @@ void Enemy::handlePatrolling(const TileMap& tileMap, const Player& player, float
 	}
 }
 
-void Enemy::handleChasing(const TileMap& tileMap, const Player& player, float fixedTimeStep)
+void Enemy::handleChasing(const TileMap& tileMap, Navigation& navigation, const Player& player, float fixedTimeStep)
 {
 	using lv::Constants::PATHFINDING_UPDATE_INTERVAL;
 
 	sf::Vector2f navPos = getNavigationPosition();
 	float distToReturn = std::hypotf(positionBeforeAggro.x - navPos.x, positionBeforeAggro.y - navPos.y);
 
-	//if (Utility::hasLineOfSight(center, playerPosition, tileMap))
+	chaseTrail.record(tileMap.getCollisionGrid(), getTilePosition(), getTrailClearance());
+
 	if (Utility::hasLineOfSightWithClearance(navPos, player.getLogicPositionCenter(), size, tileMap))
 	{
 		timeSinceGainedLOS += fixedTimeStep;
@@ -256,28 +292,39 @@ void Enemy::handleChasing(const TileMap& tileMap, const Player& player, float fi
 	{
 		timeSinceLostLOS = 0.f;
 		timeSinceGainedLOS = 0.f;
-		path.clear();
+		clearPath();
+		chasePlanner.reset();
 		state = State::Returning;
+		isFollowingTrail = startTrailReturn(tileMap);
 		return;
 	}
 
 	if (timeSinceGainedLOS >= LOS_GAINED_THRESHOLD)
 	{
-		path.clear();
+		clearPath();
 		moveTowards(player.getLogicPosition(), fixedTimeStep);
 	}
-	else
+	else if (getPathClearance() > 1)
 	{
 		if (timeSinceLastPathUpdate >= PATHFINDING_UPDATE_INTERVAL)
 		{
-			recalculatePath(tileMap, Utility::worldToTileCoords(player.getLogicPosition()));
+			recalculatePath(navigation, Utility::worldToTileCoords(player.getLogicPosition()));
+			timeSinceLastPathUpdate = 0.f;
+		}
+		followPath(fixedTimeStep);
+	}
+	else if (!followPlayerFlowField(tileMap, navigation, fixedTimeStep))
+	{
+		if (timeSinceLastPathUpdate >= PATHFINDING_UPDATE_INTERVAL &&
+			replanChase(tileMap, navigation, Utility::worldToTileCoords(player.getLogicPosition())))
+		{
 			timeSinceLastPathUpdate = 0.f;
 		}
 		followPath(fixedTimeStep);
 	}
 }
 
-void Enemy::handleReturning(const TileMap& tileMap, float fixedTimeStep)
+void Enemy::handleReturning(const TileMap& tileMap, Navigation& navigation, float fixedTimeStep)
 {
 	using lv::Constants::PATHFINDING_UPDATE_INTERVAL;
 
@@ -288,10 +335,37 @@ void Enemy::handleReturning(const TileMap& tileMap, float fixedTimeStep)
 	{
 		timeSinceGainedLOS = 0.f;
 		state = State::Patrolling;
+		isFollowingTrail = false;
+		chaseTrail.clear();
 		return;
 	}
 
-	//if (Utility::hasLineOfSight(center, positionBeforeAggro, tileMap))
+	if (isFollowingTrail)
+	{
+		// Only a change to the map can block the trail, recheck the part still ahead when it happens
+		if (trailRevision != tileMap.getRevision())
+		{
+			trailRevision = tileMap.getRevision();
+			for (std::size_t i = std::max<std::size_t>(currentPathIndex, 1); isFollowingTrail && i < path.size(); ++i)
+				isFollowingTrail = Pathfinding::hasClearLine(tileMap.getCollisionGrid(), path[i - 1], path[i], getTrailClearance());
+			if (!isFollowingTrail)
+				clearPath();
+		}
+
+		if (isFollowingTrail && currentPathIndex < path.size())
+		{
+			followPath(fixedTimeStep);
+			return;
+		}
+		if (isFollowingTrail && getTilePosition() == Utility::worldToTileCoords(positionBeforeAggro))
+		{
+			// The last crumb is the tile the chase started in, the rest of the way is a straight line
+			moveTowards(positionBeforeAggro, fixedTimeStep);
+			return;
+		}
+		isFollowingTrail = false;
+	}
+
 	if (Utility::hasLineOfSightWithClearance(navPos, positionBeforeAggro, size / 2.f, tileMap))
 		timeSinceGainedLOS += fixedTimeStep;
 	else
@@ -299,14 +373,14 @@ void Enemy::handleReturning(const TileMap& tileMap, float fixedTimeStep)
 
 	if (timeSinceGainedLOS >= LOS_GAINED_THRESHOLD)
 	{
-		path.clear();
+		clearPath();
 		moveTowards(positionBeforeAggro, fixedTimeStep);
 	}
 	else
 	{
 		if (timeSinceLastPathUpdate >= PATHFINDING_UPDATE_INTERVAL)
 		{
-			recalculatePath(tileMap, Utility::worldToTileCoords(positionBeforeAggro));
+			recalculatePath(navigation, Utility::worldToTileCoords(positionBeforeAggro));
 			timeSinceLastPathUpdate = 0.f;
 		}
 		followPath(fixedTimeStep);
@@ -323,8 +397,11 @@ void lv::Enemy::resolveCollisions(float fixedTimeStep, const TileMap& tileMap)
 	sf::Vector2f verticalFuturePos = { position.get().x, position.get().y + velocity.y * fixedTimeStep };
 	sf::FloatRect verticalBounds(verticalFuturePos, size);
 
+	// Skip the per-tile checks when there are no solid tiles anywhere near the bounds
+	bool isVerticalNearSolid = tileMap.anySolidInRect(TileMap::getOverlappedTiles(verticalBounds, 1));
+
 	for (int x = (int)(verticalBounds.position.x) / TileMap::TILE_SIZE - 1;
-		x <= (int)(verticalBounds.position.x + verticalBounds.size.x) / TileMap::TILE_SIZE + 1;
+		isVerticalNearSolid && x <= (int)(verticalBounds.position.x + verticalBounds.size.x) / TileMap::TILE_SIZE + 1;
 		++x)
 	{
 		for (int y = (int)(verticalBounds.position.y) / TileMap::TILE_SIZE - 1;
@@ -365,8 +442,11 @@ void lv::Enemy::resolveCollisions(float fixedTimeStep, const TileMap& tileMap)
 	sf::Vector2f horizontalFuturePos = { position.get().x + velocity.x * fixedTimeStep, futurePosition.y };
 	sf::FloatRect horizontalBounds(horizontalFuturePos, size);
 
+	// Skip the per-tile checks when there are no solid tiles anywhere near the bounds
+	bool isHorizontalNearSolid = tileMap.anySolidInRect(TileMap::getOverlappedTiles(horizontalBounds, 1));
+
 	for (int x = (int)(horizontalBounds.position.x) / TileMap::TILE_SIZE - 1;
-		x <= (int)(horizontalBounds.position.x + horizontalBounds.size.x) / TileMap::TILE_SIZE + 1;
+		isHorizontalNearSolid && x <= (int)(horizontalBounds.position.x + horizontalBounds.size.x) / TileMap::TILE_SIZE + 1;
 		++x)
 	{
 		for (int y = (int)(horizontalBounds.position.y) / TileMap::TILE_SIZE - 1;
@@ -411,17 +491,103 @@ void Enemy::setPosition(sf::Vector2i tilePosition)
 	position.sync();
 }
 
-void Enemy::recalculatePath(const TileMap& tileMap, sf::Vector2i target)
+void Enemy::recalculatePath(Navigation& navigation, sf::Vector2i target)
 {
 	sf::Vector2i start = getTilePosition();
 	sf::Vector2i goal = target;
 
 	if (!path.empty() && goal == path.back())
 		return; // Already at the goal
+	if (pendingPath && pendingPath->goal == goal)
+		return; // Already being searched for
+
+	// The search runs on a worker thread, the current path is followed until it is done
+	if (pendingPath)
+		pendingPath->isCancelled = true;
+	pendingPath = navigation.requestPath(start, goal, pathfindingAlgorithm, getPathClearance(), getSmoothingClearance());
+}
+
+void Enemy::collectPendingPath(const Navigation& navigation)
+{
+	using lv::Constants::PATHFINDING_UPDATE_INTERVAL;
 
-	using namespace Pathfinding;
-	path = findPathAStar(tileMap, start, goal);
+	if (!pendingPath || !pendingPath->isDone)
+		return;
+
+	if (navigation.isCurrent(*pendingPath))
+	{
+		path = std::move(pendingPath->path);
+		currentPathIndex = 0;
+
+		// The enemy kept moving while the search ran, skip whatever part of the path it already covered
+		auto current = std::find(path.begin(), path.end(), getTilePosition());
+		if (current != path.end())
+			currentPathIndex = static_cast<std::size_t>(current - path.begin()) + 1;
+	}
+	else
+	{
+		// Searched against a map that has changed since, ask again right away
+		timeSinceLastPathUpdate = PATHFINDING_UPDATE_INTERVAL;
+	}
+	pendingPath.reset();
+}
+
+bool Enemy::replanChase(const TileMap& tileMap, Navigation& navigation, sf::Vector2i target)
+{
+	using lv::Constants::PATHFINDING_NODES_PER_SEARCH;
+
+	sf::Vector2i start = getTilePosition();
+	if (Pathfinding::isUnreachable(tileMap.getCollisionGrid(), start, target))
+	{
+		// E.g. the player is hiding in a sealed room, don't let the planner flood this whole region
+		clearPath();
+		return true;
+	}
+
+	chasePlanner.setEndpoints(start, target);
+	int claimed = navigation.claimNodeBudget(PATHFINDING_NODES_PER_SEARCH);
+	navigation.releaseNodeBudget(claimed - chasePlanner.update(tileMap, claimed));
+	if (!chasePlanner.isFinished())
+		return false; // Not settled yet, keep following the old path and continue next update
+
+	clearPath();
+	if (chasePlanner.getPath(path) && isPathSmoothed)
+		Pathfinding::smoothPath(tileMap.getCollisionGrid(), start, path, getSmoothingClearance());
+	return true;
+}
+
+void Enemy::clearPath()
+{
+	path.clear();
+	currentPathIndex = 0;
+
+	if (pendingPath)
+	{
+		pendingPath->isCancelled = true;
+		pendingPath.reset();
+	}
+}
+
+bool Enemy::startTrailReturn(const TileMap& tileMap)
+{
+	if (chaseTrail.isEmpty() || !chaseTrail.isWalkable(tileMap.getCollisionGrid(), getTrailClearance()))
+		return false;
+
+	chaseTrail.getReversed(path);
 	currentPathIndex = 0;
+	trailRevision = tileMap.getRevision();
+	return true;
+}
+
+bool Enemy::startPatrolLeg(std::size_t from)
+{
+	const std::vector<sf::Vector2i>* leg = patrolRoute.getLeg(from);
+	if (!leg)
+		return false;
+
+	clearPath();
+	path = *leg;
+	return true;
 }
 
 void lv::Enemy::followPath(float fixedTimeStep)
@@ -451,6 +617,32 @@ void lv::Enemy::followPath(float fixedTimeStep)
 	moveTowards(target, fixedTimeStep);
 }
 
+bool Enemy::followPlayerFlowField(const TileMap& tileMap, Navigation& navigation, float fixedTimeStep)
+{
+	// Anything other than a single pending step is a searched path (or nothing), replace it.
+	// A step that has just been reached is replaced right away too, so the enemy does not
+	//  stop for a tick at every tile.
+	bool needsNextStep = path.size() != 1 || currentPathIndex >= path.size();
+	if (!needsNextStep)
+	{
+		sf::Vector2f center = getNavigationPosition();
+		sf::Vector2f target = getPathTargetPosition(path.front());
+		needsNextStep = std::hypotf(target.x - center.x, target.y - center.y) <= PATH_TOLERANCE;
+	}
+
+	if (needsNextStep)
+	{
+		sf::Vector2i next;
+		if (!navigation.getStepTowardsPlayer(tileMap, getTilePosition(), next))
+			return false;
+
+		clearPath();
+		path.assign(1, next);
+	}
+	followPath(fixedTimeStep);
+	return true;
+}
+
 sf::Vector2f Enemy::getNavigationPosition() const
 {
 	return position.get() + getNavigationPositionLocal();
@@ -479,27 +671,25 @@ void Enemy::initializeDebugVisuals()
 	d_followRangeCircle.setOutlineThickness(1.f);
 }
 
-void Enemy::updateDebugVisuals(const TileMap& tileMap, sf::FloatRect playerBounds)
+void Enemy::updateDebugVisuals(const TileMap& tileMap, const Navigation& navigation, const Player& player)
 {
-	bool hasLineOfSight = Utility::hasLineOfSight(getEyePosition(), playerBounds, tileMap);
+	bool hasLineOfSight = canSeePlayer(tileMap, navigation, player);
+	sf::FloatRect playerBounds = player.getBounds();
 	sf::Color lineColor = hasLineOfSight ? sf::Color(0, 255, 0, 150) : sf::Color(255, 0, 0, 150);
 	d_lineOfSightLine = sf::VertexArray(sf::PrimitiveType::Lines, 2);
 
-	std::vector<sf::Vector2f> corners =
-	{
+	const std::array<sf::Vector2f, 4> corners =
+	{ {
 		{playerBounds.position.x, playerBounds.position.y},
 		{playerBounds.position.x + playerBounds.size.x, playerBounds.position.y},
 		{playerBounds.position.x, playerBounds.position.y + playerBounds.size.y},
 		{playerBounds.position.x + playerBounds.size.x, playerBounds.position.y + playerBounds.size.y}
-	};
+	} };
 
 	for (const auto& corner : corners)
 	{
-		//if (Utility::hasLineOfSight(getEyePosition(), corner, tileMap))
-		//{
-			d_lineOfSightLine.append(sf::Vertex{ getEyePosition(), lineColor });
-			d_lineOfSightLine.append(sf::Vertex{ corner, lineColor });
-		//}
+		d_lineOfSightLine.append(sf::Vertex{ getEyePosition(), lineColor });
+		d_lineOfSightLine.append(sf::Vertex{ corner, lineColor });
 	}
 
 	d_patrolTargetCircle.setPosition(TileMap::getTileCenter(patrolPositions.at(currentPatrolIndex)) - sf::Vector2f(d_patrolTargetCircle.getRadius(), d_patrolTargetCircle.getRadius()));
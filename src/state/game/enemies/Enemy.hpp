@@ -13,6 +13,7 @@
 
 // STL
 #include <vector>
+#include <memory>
 // SFML
 #include <SFML/Graphics/RenderTarget.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
@@ -24,8 +25,13 @@
 #include "../../../core/Position.hpp"
 #include "../../../core/Serializable.hpp"
 #include "../../../world/TileMap.hpp"
+#include "../../../world/Pathfinding.hpp"
+#include "../../../world/DStarLite.hpp"
+#include "../../../world/PatrolRoute.hpp"
+#include "../../../world/BreadcrumbTrail.hpp"
 
 class Player;
+class Navigation;
 
 namespace lv
 {
@@ -42,7 +48,7 @@ namespace lv
         virtual ~Enemy() = default;
         virtual std::unique_ptr<Enemy> clone() const = 0;
 
-        virtual void update(float fixedTimeStep, const TileMap& tileMap, const Player& player) = 0;
+        virtual void update(float fixedTimeStep, const TileMap& tileMap, Navigation& navigation, const Player& player) = 0;
         virtual void render(sf::RenderTarget& target, const sf::Font& font, float interpolationFactor) = 0;
 
 		// ---- Serialization ----
@@ -56,7 +62,11 @@ namespace lv
 
         // ---- LOS ----
         virtual sf::Vector2f getEyePosition() const = 0;
-        virtual bool canSeePlayer(const Player& player) const;
+        // Whether the player is within aggro range and a ray from this enemy's eye reaches a corner of
+        //  the player's bounds. The visibility field `navigation` shares between all enemies is checked
+        //  first and rules most enemies out with a lookup; since it lets through some tiles a ray would
+        //  not (see `VisibilityField`), the rays are only cast for those it accepts.
+        virtual bool canSeePlayer(const TileMap& tileMap, const Navigation& navigation, const Player& player) const;
 
         // ---- Patrolling ----
         virtual bool isValidPatrolPosition(const TileMap& tileMap, sf::Vector2i tilePosition) const = 0;
@@ -86,7 +96,8 @@ namespace lv
         // ---- Debug ----
         void toggleSelected() { isSelected = !isSelected; }
         void setSelected(bool selected) { isSelected = selected; }
-        void updateDebugVisuals(const TileMap& tileMap, sf::FloatRect playerBounds);
+        // The line of sight lines are green when `canSeePlayer()` is true
+        void updateDebugVisuals(const TileMap& tileMap, const Navigation& navigation, const Player& player);
         void renderDebugVisuals(sf::RenderTarget& target, const sf::Font& font, float interpolationFactor);
 
     protected:
@@ -102,10 +113,10 @@ namespace lv
         sf::Color color;
 
         // ---- Position and Movement ----
-		virtual void updateMovement(const TileMap& tileMap, const Player& player, float fixedTimeStep);
-        virtual void handlePatrolling(const TileMap& tileMap, const Player& player, float fixedTimeStep);
-        virtual void handleChasing(const TileMap& tileMap, const Player& player, float fixedTimeStep);
-        virtual void handleReturning(const TileMap& tileMap, float fixedTimeStep);
+		virtual void updateMovement(const TileMap& tileMap, Navigation& navigation, const Player& player, float fixedTimeStep);
+        virtual void handlePatrolling(const TileMap& tileMap, Navigation& navigation, const Player& player, float fixedTimeStep);
+        virtual void handleChasing(const TileMap& tileMap, Navigation& navigation, const Player& player, float fixedTimeStep);
+        virtual void handleReturning(const TileMap& tileMap, Navigation& navigation, float fixedTimeStep);
         virtual void moveTowards(sf::Vector2f target, float fixedTimeStep) = 0;
         void resolveCollisions(float fixedTimeStep, const TileMap& tileMap);
         void setPosition(sf::Vector2i tilePosition);
@@ -133,13 +144,50 @@ namespace lv
         // ---- Patrolling ----
         std::vector<sf::Vector2i> patrolPositions;
 		std::size_t currentPatrolIndex = 0;
+		Pathfinding::PatrolRoute patrolRoute; // Paths between the patrol positions, see `startPatrolLeg()`
+		bool isFollowingPatrolLeg; // Whether `path` is a leg of `patrolRoute` that leads to the current patrol target
         sf::Vector2f positionBeforeAggro;
         bool isCompleted;
 
+        // ---- Returning ----
+        // Starts walking the chase trail back towards `positionBeforeAggro`.
+        // Returns false if it is empty or blocked, in which case the enemy searches its way back.
+        bool startTrailReturn(const TileMap& tileMap);
+
+        Pathfinding::BreadcrumbTrail chaseTrail; // Tiles passed since the chase started
+        bool isFollowingTrail; // Whether `path` is `chaseTrail` reversed
+        std::uint64_t trailRevision; // Map revision `path` was last checked against while following the trail
+
         // ---- Pathfinding ----
         ///virtual bool requiresPathfinding() const = 0;
-        virtual void recalculatePath(const TileMap& tileMap, sf::Vector2i target);
+        // Requests a new path to `target`, which is picked up by `collectPendingPath()` once ready
+        virtual void recalculatePath(Navigation& navigation, sf::Vector2i target);
+        // Takes over the result of the pending path request if it has finished,
+        //  unless it was searched against an older version of the map
+        void collectPendingPath(const Navigation& navigation);
+        // Updates the path to `target` with the chase planner, which repairs its previous search
+        //  instead of starting over. The search is spread over several updates if it does not fit
+        //  in the node budget; returns true once the path has been updated.
+        bool replanChase(const TileMap& tileMap, Navigation& navigation, sf::Vector2i target);
+        // Clearance the tiles of a path must have for this enemy's bounds to fit around their centres.
+        // The shared flow field and the chase planner only know about free tiles, so enemies that
+        //  need more than 1 always search with `recalculatePath()` instead.
+        inline int getPathClearance() const { return TileMap::getRequiredClearanceAtCenter(size); }
+        // Clearance for skipping waypoints (see `Pathfinding::smoothPath()`), 0 if paths are not smoothed
+        inline int getSmoothingClearance() const { return isPathSmoothed ? TileMap::getRequiredClearance(size) : 0; }
+        // Clearance for walking the chase trail back. Once full it is thinned into long straight lines,
+        //  anywhere along which the bounds must fit, like a smoothed path.
+        inline int getTrailClearance() const { return TileMap::getRequiredClearance(size); }
+        // Clears the path and drops any pending path request
+        void clearPath();
+        // Starts following the stored path from patrol position `from` to the current patrol target.
+        // Returns false if there is none (or its search has not finished), in which case the enemy has to find its own way there.
+        bool startPatrolLeg(std::size_t from);
         virtual void followPath(float fixedTimeStep);
+        // Steps along the flow field towards the player that all chasing enemies share,
+        //  taking a new step from it whenever the previous one is reached.
+        // Returns false if the enemy is outside the field and has to search on its own.
+        bool followPlayerFlowField(const TileMap& tileMap, Navigation& navigation, float fixedTimeStep);
         // Returns the pixel position of the Enemy used for pathfinding,
         //  e.g. the center of the bounds for flying enemies,
 		//  or the bottom center (feet) for walking enemies.
@@ -164,6 +212,10 @@ namespace lv
 		const float PATH_TOLERANCE = 5.f; // Tolerance in pixels for pathfinding to consider the enemy at the target tile
         std::vector<sf::Vector2i> path;
         std::size_t currentPathIndex = 0;
+        std::shared_ptr<Pathfinding::PathRequest> pendingPath; // Search still running on a worker thread, if any
+		Pathfinding::Algorithm pathfindingAlgorithm; // Search used by `recalculatePath()`, set per enemy type
+		bool isPathSmoothed; // Whether searched paths are reduced to the waypoints around corners, set per enemy type
+		Pathfinding::DStarLite chasePlanner; // Kept between replans while chasing, see `replanChase()`
 		float timeSinceLastPathUpdate; // Time since the last pathfinding update - use lv::Constants::PATHFINDING_UPDATE_INTERVAL to limit updates
 
 		// ---- Debug ----
@@ -33,6 +33,8 @@ FlyingEnemy::FlyingEnemy() :
 	chaseSpeed = 125.f; // TODO: Change to tiles per second?
 	aggroRange = 8 * TileMap::TILE_SIZE;
 	followRange = 12 * TileMap::TILE_SIZE;
+	pathfindingAlgorithm = Pathfinding::Algorithm::JumpPointSearch;
+	isPathSmoothed = true;
 
 	initializeDebugVisuals();
 
@@ -54,13 +56,13 @@ void FlyingEnemy::deserialize(const json& j)
 	Enemy::deserialize(j);
 }
 
-void FlyingEnemy::update(float fixedTimeStep, const TileMap& tileMap, const Player& player)
+void FlyingEnemy::update(float fixedTimeStep, const TileMap& tileMap, Navigation& navigation, const Player& player)
 {
-	updateMovement(tileMap, player, fixedTimeStep);
+	updateMovement(tileMap, navigation, player, fixedTimeStep);
 	resolveCollisions(fixedTimeStep, tileMap);
 
 	if (Game::getInstance().isDebugModeOn())
-		updateDebugVisuals(tileMap, player.getBounds());
+		updateDebugVisuals(tileMap, navigation, player);
 }
 
 void FlyingEnemy::render(sf::RenderTarget& target, const sf::Font& font, float interpolationFactor)
@@ -22,7 +22,7 @@ namespace lv
 		FlyingEnemy();
 		std::unique_ptr<Enemy> clone() const override;
 
-		void update(float fixedTimeStep, const TileMap& tileMap, const Player& player) override;
+		void update(float fixedTimeStep, const TileMap& tileMap, Navigation& navigation, const Player& player) override;
 		void render(sf::RenderTarget& target, const sf::Font& font, float interpolationFactor) override;
 
 		// ---- Serialization ----
@@ -12,6 +12,7 @@
 
 #include <memory>
 #include "TileMap.hpp"
+#include "Navigation.hpp"
 #include "../state/game/enemies/Enemy.hpp"
 #include "../state/game/Player.hpp"
 
@@ -24,6 +25,7 @@ public:
 	bool save(const std::string& filename) const;
 
 	TileMap map;
+	Navigation navigation; // Pathfinding data for `map`, shared by all enemies in the Area
 	Player& player;
 	std::vector<std::unique_ptr<lv::Enemy>> enemies;
 
@@ -0,0 +1,92 @@
+// ================================================================================================
+// File: BreadcrumbTrail.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include "BreadcrumbTrail.hpp"
+#include "Pathfinding.hpp"
+
+using Pathfinding::BreadcrumbTrail;
+
+BreadcrumbTrail::BreadcrumbTrail() :
+	crumbs{},
+	first(0),
+	count(0)
+{
+}
+
+void BreadcrumbTrail::clear()
+{
+	first = 0;
+	count = 0;
+}
+
+void BreadcrumbTrail::record(const CollisionGrid& grid, sf::Vector2i tile, int minClearance)
+{
+	if (count > 0 && getCrumb(count - 1) == tile)
+		return;
+
+	// Back on a tile the trail passed before, whatever came after that visit was a detour
+	for (std::size_t i = count; i-- > 0;)
+	{
+		if (getCrumb(i) == tile)
+		{
+			count = i + 1;
+			return;
+		}
+	}
+
+	if (count == CAPACITY && thin(grid, minClearance) == 0)
+	{
+		first = (first + 1) % CAPACITY;
+		--count;
+	}
+	crumbAt(count) = tile;
+	++count;
+}
+
+std::size_t BreadcrumbTrail::thin(const CollisionGrid& grid, int minClearance)
+{
+	if (count < 3)
+		return 0;
+
+	// Like `smoothPath()`, but the oldest and the newest crumb always stay. Crumbs are only ever
+	//  moved towards the front, so the ring can be compacted in place.
+	std::size_t kept = 1;
+	std::size_t anchor = 0;
+	for (std::size_t i = 1; i + 1 < count; ++i)
+	{
+		if (!hasClearLine(grid, getCrumb(anchor), getCrumb(i + 1), minClearance))
+		{
+			crumbAt(kept) = getCrumb(i);
+			anchor = kept++;
+		}
+	}
+	crumbAt(kept) = getCrumb(count - 1);
+	++kept;
+
+	std::size_t dropped = count - kept;
+	count = kept;
+	return dropped;
+}
+
+bool BreadcrumbTrail::isWalkable(const CollisionGrid& grid, int minClearance) const
+{
+	for (std::size_t i = 1; i < count; ++i)
+	{
+		if (!hasClearLine(grid, getCrumb(i), getCrumb(i - 1), minClearance))
+			return false;
+	}
+	return true;
+}
+
+void BreadcrumbTrail::getReversed(std::vector<sf::Vector2i>& outPath) const
+{
+	outPath.clear();
+	for (std::size_t i = count; i-- > 0;)
+		outPath.push_back(getCrumb(i));
+}
@@ -0,0 +1,58 @@
+// ================================================================================================
+// File: BreadcrumbTrail.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the BreadcrumbTrail class, a fixed-size record of the tiles an enemy has
+//              passed, which it can walk back along instead of searching for a path.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstddef>
+#include <SFML/System/Vector2.hpp>
+#include "CollisionGrid.hpp"
+
+namespace Pathfinding
+{
+	// The tiles a mover passed through (crumbs), oldest first, in a ring buffer that never allocates.
+	// Loops are cut out as they are recorded, and once the buffer is full the crumbs that can be
+	//  skipped in a clear straight line are dropped, so a long trail keeps its start.
+	class BreadcrumbTrail
+	{
+	public:
+		BreadcrumbTrail();
+
+		void clear();
+		// Adds `tile` unless it is the last crumb already. If the trail passed `tile` before, the
+		//  crumbs after that visit are dropped instead. `minClearance` is used to thin the trail out
+		//  when it is full (see `hasClearLine()`); only if nothing can be thinned is the oldest crumb lost.
+		void record(const CollisionGrid& grid, sf::Vector2i tile, int minClearance);
+
+		// Returns true if the trail can still be walked back with `minClearance`, i.e. the straight
+		//  line between every two consecutive crumbs is clear
+		bool isWalkable(const CollisionGrid& grid, int minClearance) const;
+		// Replaces `outPath` with the crumbs from the newest to the oldest
+		void getReversed(std::vector<sf::Vector2i>& outPath) const;
+
+		inline bool isEmpty() const { return count == 0; }
+		inline std::size_t getSize() const { return count; }
+		// Oldest first
+		inline sf::Vector2i getCrumb(std::size_t index) const { return crumbs[(first + index) % CAPACITY]; }
+
+		static constexpr std::size_t CAPACITY = 64;
+
+	private:
+		inline sf::Vector2i& crumbAt(std::size_t index) { return crumbs[(first + index) % CAPACITY]; }
+		// Drops every crumb the trail can skip, returns the number dropped
+		std::size_t thin(const CollisionGrid& grid, int minClearance);
+
+		std::array<sf::Vector2i, CAPACITY> crumbs;
+		std::size_t first; // Index of the oldest crumb in `crumbs`
+		std::size_t count;
+	};
+}
@@ -0,0 +1,662 @@
+// ================================================================================================
+// File: CollisionGrid.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <algorithm>
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define COLLISIONGRID_USE_SSE2
+#endif
+#include "CollisionGrid.hpp"
+
+CollisionGrid::CollisionGrid() :
+	width(0),
+	height(0),
+	wordsPerRow(0),
+	hasMergedRegions(false),
+	refineCursor(-1),
+	refineFirstLabel(0),
+	refineLabel(-1),
+	refineRoot(-1),
+	refineNext(0)
+{
+}
+
+CollisionGrid::CollisionGrid(const CollisionGrid& other) :
+	CollisionGrid()
+{
+	*this = other;
+}
+
+CollisionGrid& CollisionGrid::operator=(const CollisionGrid& other)
+{
+	if (this == &other)
+		return *this;
+
+	// Assigned member by member so a grid copied into again reuses its buffers
+	width = other.width;
+	height = other.height;
+	solidBits = other.solidBits;
+	wordsPerRow = other.wordsPerRow;
+	clearance = other.clearance;
+	tileLabels = other.tileLabels;
+	labelParent = other.labelParent;
+	labelSize = other.labelSize;
+	hasMergedRegions = other.hasMergedRegions;
+	refineCursor = other.refineCursor;
+	refineFirstLabel = other.refineFirstLabel;
+	refineLabel = other.refineLabel;
+	refineRoot = other.refineRoot;
+	refineNext = other.refineNext;
+	refineQueue = other.refineQueue;
+	neighborMasks = other.neighborMasks;
+	pendingChanges = other.pendingChanges;
+	return *this;
+}
+
+void CollisionGrid::resize(int width, int height)
+{
+	this->width = width;
+	this->height = height;
+	wordsPerRow = (width + 63) / 64;
+	solidBits.assign(static_cast<std::size_t>(wordsPerRow) * height, 0);
+
+	clearance.assign(static_cast<std::size_t>(width) * height, 0);
+	computeClearance(sf::IntRect({ 0, 0 }, { width, height }));
+
+	neighborMasks.assign(static_cast<std::size_t>(width) * height, 0);
+	computeNeighborMasks(sf::IntRect({ 0, 0 }, { width, height }));
+
+	pendingChanges.clear();
+	labelAllRegions();
+}
+
+void CollisionGrid::setSolid(int x, int y, bool isSolid)
+{
+	std::uint64_t& word = solidBits[static_cast<std::size_t>(y) * wordsPerRow + (x >> 6)];
+	std::uint64_t bit = std::uint64_t(1) << (x & 63);
+	if (((word & bit) != 0) == isSolid)
+		return;
+
+	if (isSolid)
+		word |= bit;
+	else
+		word &= ~bit;
+	pendingChanges.emplace_back(x, y);
+}
+
+void CollisionGrid::applyChanges()
+{
+	if (pendingChanges.empty())
+		return;
+
+	updateClearance();
+	updateNeighborMasks();
+	updateRegions();
+	pendingChanges.clear();
+
+	// A refinement pass assumes the tiles stay as they were when it started. Labels it already
+	//  handed out are left alone: a region still being flooded keeps pointing to its old label.
+	refineCursor = -1;
+	refineLabel = -1;
+	refineQueue.clear();
+}
+
+sf::IntRect CollisionGrid::getChangedArea(int margin) const
+{
+	sf::Vector2i topLeft = pendingChanges.front();
+	sf::Vector2i bottomRight = pendingChanges.front();
+	for (sf::Vector2i tile : pendingChanges)
+	{
+		topLeft = { std::min(topLeft.x, tile.x), std::min(topLeft.y, tile.y) };
+		bottomRight = { std::max(bottomRight.x, tile.x), std::max(bottomRight.y, tile.y) };
+	}
+	topLeft = { std::max(topLeft.x - margin, 0), std::max(topLeft.y - margin, 0) };
+	bottomRight = { std::min(bottomRight.x + margin, width - 1), std::min(bottomRight.y + margin, height - 1) };
+	return sf::IntRect(topLeft, bottomRight - topLeft + sf::Vector2i(1, 1));
+}
+
+void CollisionGrid::updateClearance()
+{
+	// A tile only affects the clearance of tiles less than MAX_CLEARANCE away from it, and those
+	//  only depend on solid tiles less than MAX_CLEARANCE away from them
+	constexpr int reach = MAX_CLEARANCE - 1;
+	constexpr int areaSize = 2 * reach + 1;
+
+	// One area around all of the changes when that is no larger than the areas around each of them
+	//  (e.g. for a filled rectangle, or many changes all over the map). The margin `computeClearance()`
+	//  adds makes small areas relatively expensive, hence the factor of 4.
+	sf::IntRect changedArea = getChangedArea(reach);
+	if (static_cast<std::size_t>(changedArea.size.x) * changedArea.size.y <= pendingChanges.size() * areaSize * areaSize * 4)
+	{
+		computeClearance(changedArea);
+	}
+	else
+	{
+		for (sf::Vector2i tile : pendingChanges)
+			computeClearance(sf::IntRect({ tile.x - reach, tile.y - reach }, { areaSize, areaSize }));
+	}
+}
+
+void CollisionGrid::computeClearance(const sf::IntRect& area)
+{
+	// Two-pass distance transform over the area plus a margin of MAX_CLEARANCE tiles, so every
+	//  solid tile that can matter for the area is included. Tiles outside the map count as solid;
+	//  tiles past the margin count as free, which can only be wrong inside the margin itself.
+	const int left = std::max(area.position.x - MAX_CLEARANCE, 0);
+	const int top = std::max(area.position.y - MAX_CLEARANCE, 0);
+	const int right = std::min(area.position.x + area.size.x + MAX_CLEARANCE, width);
+	const int bottom = std::min(area.position.y + area.size.y + MAX_CLEARANCE, height);
+	const int localWidth = right - left;
+	const int localHeight = bottom - top;
+	if (localWidth <= 0 || localHeight <= 0)
+		return;
+
+	clearanceScratch.resize(static_cast<std::size_t>(localWidth) * localHeight);
+	std::uint8_t* distances = clearanceScratch.data();
+
+	auto at = [&](int x, int y) -> int
+		{
+			// Past the map edge everything is solid, past the margin (inside the map) assume free
+			if (x < 0 || x >= localWidth || y < 0 || y >= localHeight)
+				return (left + x < 0 || left + x >= width || top + y < 0 || top + y >= height) ? 0 : MAX_CLEARANCE;
+			return distances[y * localWidth + x];
+		};
+
+	for (int y = 0; y < localHeight; ++y)
+	{
+		for (int x = 0; x < localWidth; ++x)
+		{
+			int value = 0;
+			if (!isSolid(left + x, top + y))
+			{
+				value = std::min({ at(x - 1, y), at(x - 1, y - 1), at(x, y - 1), at(x + 1, y - 1) }) + 1;
+				value = std::min(value, static_cast<int>(MAX_CLEARANCE));
+			}
+			distances[y * localWidth + x] = static_cast<std::uint8_t>(value);
+		}
+	}
+	for (int y = localHeight - 1; y >= 0; --y)
+	{
+		for (int x = localWidth - 1; x >= 0; --x)
+		{
+			std::uint8_t& value = distances[y * localWidth + x];
+			int fromBelow = std::min({ at(x + 1, y), at(x + 1, y + 1), at(x, y + 1), at(x - 1, y + 1) }) + 1;
+			if (fromBelow < value)
+				value = static_cast<std::uint8_t>(fromBelow);
+		}
+	}
+
+	// Only the area itself is exact, the margin was just there to feed it
+	const int areaLeft = std::max(area.position.x, 0);
+	const int areaTop = std::max(area.position.y, 0);
+	const int areaRight = std::min(area.position.x + area.size.x, width);
+	const int areaBottom = std::min(area.position.y + area.size.y, height);
+	for (int y = areaTop; y < areaBottom; ++y)
+	{
+		for (int x = areaLeft; x < areaRight; ++x)
+			clearance[static_cast<std::size_t>(y) * width + x] = distances[(y - top) * localWidth + (x - left)];
+	}
+}
+
+bool CollisionGrid::anySolidInRect(const sf::IntRect& tileRect) const
+{
+	int left = std::max(tileRect.position.x, 0);
+	int top = std::max(tileRect.position.y, 0);
+	int right = std::min(tileRect.position.x + tileRect.size.x, width) - 1;
+	int bottom = std::min(tileRect.position.y + tileRect.size.y, height) - 1;
+
+	if (left > right || top > bottom)
+		return false;
+
+	int firstWord = left >> 6;
+	int lastWord = right >> 6;
+	std::uint64_t firstMask = ~std::uint64_t(0) << (left & 63);
+	std::uint64_t lastMask = ~std::uint64_t(0) >> (63 - (right & 63));
+
+	const std::uint64_t* row = &solidBits[static_cast<std::size_t>(top) * wordsPerRow];
+
+	// Narrow rectangles (the usual hitbox) fit within a single word per row
+	if (firstWord == lastWord)
+	{
+		std::uint64_t mask = firstMask & lastMask;
+		for (int y = top; y <= bottom; ++y, row += wordsPerRow)
+			if (row[firstWord] & mask)
+				return true;
+		return false;
+	}
+
+	for (int y = top; y <= bottom; ++y, row += wordsPerRow)
+	{
+		if ((row[firstWord] & firstMask) || (row[lastWord] & lastMask))
+			return true;
+
+		int word = firstWord + 1;
+#ifdef COLLISIONGRID_USE_SSE2
+		// Full words in between are OR-ed together two at a time
+		__m128i accumulated = _mm_setzero_si128();
+		for (; word + 1 < lastWord; word += 2)
+			accumulated = _mm_or_si128(accumulated, _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + word)));
+		if (_mm_movemask_epi8(_mm_cmpeq_epi8(accumulated, _mm_setzero_si128())) != 0xFFFF)
+			return true;
+#endif
+		for (; word < lastWord; ++word)
+			if (row[word])
+				return true;
+	}
+	return false;
+}
+
+void CollisionGrid::updateNeighborMasks()
+{
+	// A tile only appears in the masks of the tiles around it, as a target or beside a diagonal
+	sf::IntRect changedArea = getChangedArea(1);
+	if (static_cast<std::size_t>(changedArea.size.x) * changedArea.size.y <= pendingChanges.size() * 9 * 4)
+	{
+		computeNeighborMasks(changedArea);
+		return;
+	}
+	for (sf::Vector2i tile : pendingChanges)
+		computeNeighborMasks(sf::IntRect({ tile.x - 1, tile.y - 1 }, { 3, 3 }));
+}
+
+void CollisionGrid::computeNeighborMasks(const sf::IntRect& area)
+{
+	const int left = std::max(area.position.x, 0);
+	const int top = std::max(area.position.y, 0);
+	const int right = std::min(area.position.x + area.size.x, width);
+	const int bottom = std::min(area.position.y + area.size.y, height);
+
+	auto isFree = [&](int x, int y) { return isWithinBounds(x, y) && !isSolid(x, y); };
+
+	for (int y = top; y < bottom; ++y)
+	{
+		for (int x = left; x < right; ++x)
+		{
+			std::uint8_t mask = 0;
+			for (int direction = 0; direction < 8; ++direction)
+			{
+				const int dx = NEIGHBOR_OFFSETS[direction][0];
+				const int dy = NEIGHBOR_OFFSETS[direction][1];
+				if (!isFree(x + dx, y + dy))
+					continue;
+				if (dx != 0 && dy != 0 && (!isFree(x + dx, y) || !isFree(x, y + dy)))
+					continue;
+				mask |= static_cast<std::uint8_t>(1u << direction);
+			}
+			neighborMasks[static_cast<std::size_t>(y) * width + x] = mask;
+		}
+	}
+}
+
+int CollisionGrid::getRegion(int x, int y) const
+{
+	if (!isWithinBounds(x, y))
+		return -1;
+
+	int label = tileLabels[static_cast<std::size_t>(y) * width + x];
+	return label < 0 ? -1 : findLabel(label);
+}
+
+void CollisionGrid::updateRegions()
+{
+	// Splits and refinement passes add labels, so the label list grows with every edit; start over
+	//  once it is much longer than the number of tiles (or when there are a lot of changes anyway).
+	// It takes at least a label per tile of edits to get there, so this is cheap on average.
+	if (labelParent.size() > tileLabels.size() * 2 || pendingChanges.size() * 64 >= tileLabels.size())
+	{
+		labelAllRegions();
+		return;
+	}
+
+	constexpr sf::Vector2i neighbors[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+	// Freed tiles join the regions next to them (and join those regions together)
+	for (sf::Vector2i tile : pendingChanges)
+	{
+		int& label = tileLabels[static_cast<std::size_t>(tile.y) * width + tile.x];
+		if (isSolid(tile.x, tile.y))
+		{
+			label = -1;
+			continue;
+		}
+		if (label >= 0)
+			continue; // Listed twice
+		label = addLabel();
+	}
+	for (sf::Vector2i tile : pendingChanges)
+	{
+		int label = tileLabels[static_cast<std::size_t>(tile.y) * width + tile.x];
+		if (label < 0)
+			continue;
+
+		for (sf::Vector2i offset : neighbors)
+		{
+			int neighborRegion = getRegion(tile + offset);
+			int region = findLabel(label);
+			if (neighborRegion < 0 || neighborRegion == region)
+				continue;
+
+			// Union by size keeps the trees shallow, so lookups stay cheap without path compression
+			if (labelSize[region] < labelSize[neighborRegion])
+				std::swap(region, neighborRegion);
+			labelParent[neighborRegion] = region;
+			labelSize[region] += labelSize[neighborRegion];
+		}
+	}
+
+	// Tiles made solid may have cut their region apart; the free tiles next to them are searched
+	//  from, one region at a time. A single tile whose neighbours stay connected around it cannot
+	//  have, but that test looks at the tiles around it as they are now, so it only holds on its own:
+	//  two tiles blocking a corridor together both pass it.
+	const bool isSingleChange = pendingChanges.size() == 1;
+	splitSeeds.clear();
+	for (sf::Vector2i tile : pendingChanges)
+	{
+		if (!isSolid(tile.x, tile.y) || (isSingleChange && isBypassable(tile.x, tile.y)))
+			continue;
+
+		for (sf::Vector2i offset : neighbors)
+		{
+			sf::Vector2i neighbor = tile + offset;
+			if (isWithinBounds(neighbor) && !isSolid(neighbor))
+				splitSeeds.emplace_back(getRegion(neighbor), neighbor);
+		}
+	}
+	std::sort(splitSeeds.begin(), splitSeeds.end(), [](const auto& a, const auto& b) { return a.first < b.first; });
+
+	for (std::size_t first = 0; first < splitSeeds.size();)
+	{
+		std::size_t last = first + 1;
+		while (last < splitSeeds.size() && splitSeeds[last].first == splitSeeds[first].first)
+			++last;
+		splitRegion(splitSeeds[first].first, first, last);
+		first = last;
+	}
+	splitSeeds.clear();
+}
+
+void CollisionGrid::splitRegion(int root, std::size_t firstSeed, std::size_t lastSeed)
+{
+	constexpr sf::Vector2i neighbors[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+	// Every label from here up belongs to one of the searches, so a tile with a lower label has
+	//  not been reached yet
+	const int firstLabel = static_cast<int>(labelParent.size());
+	auto getLabel = [this](sf::Vector2i tile) -> int& { return tileLabels[static_cast<std::size_t>(tile.y) * width + tile.x]; };
+
+	std::size_t searchCount = 0;
+	for (std::size_t i = firstSeed; i < lastSeed; ++i)
+	{
+		sf::Vector2i seed = splitSeeds[i].second;
+		if (getLabel(seed) >= firstLabel)
+			continue; // Next to more than one of the changed tiles
+
+		if (searchCount == splitSearches.size())
+			splitSearches.emplace_back();
+		SplitSearch& search = splitSearches[searchCount++];
+		search.label = addLabel();
+		search.tiles.assign(1, seed);
+		search.next = 0;
+		getLabel(seed) = search.label;
+	}
+
+	// Advance every search a tile at a time until at most one group of them is still running: the
+	//  others have each reached all of a part that is cut off from the rest. Stop early once
+	//  MAX_SPLIT_SEARCH_TILES have been explored.
+	int exploredCount = 0;
+	bool isSplitOpen = false;
+	while (true)
+	{
+		int runningGroup = -1;
+		isSplitOpen = false;
+		for (std::size_t i = 0; i < searchCount && !isSplitOpen; ++i)
+		{
+			const SplitSearch& search = splitSearches[i];
+			if (search.next == search.tiles.size())
+				continue;
+			int group = findLabel(search.label);
+			isSplitOpen = runningGroup >= 0 && group != runningGroup;
+			runningGroup = group;
+		}
+		if (!isSplitOpen || exploredCount >= MAX_SPLIT_SEARCH_TILES)
+			break;
+
+		for (std::size_t i = 0; i < searchCount; ++i)
+		{
+			SplitSearch& search = splitSearches[i];
+			if (search.next == search.tiles.size())
+				continue;
+
+			sf::Vector2i tile = search.tiles[search.next++];
+			++exploredCount;
+			for (sf::Vector2i offset : neighbors)
+			{
+				sf::Vector2i neighbor = tile + offset;
+				if (!isWithinBounds(neighbor) || isSolid(neighbor))
+					continue;
+
+				int& label = getLabel(neighbor);
+				if (label < firstLabel)
+				{
+					label = search.label;
+					search.tiles.push_back(neighbor);
+					continue;
+				}
+				// Reached by another search, so both are on the same side of the split
+				int group = findLabel(search.label);
+				int otherGroup = findLabel(label);
+				if (group != otherGroup)
+					labelParent[std::max(group, otherGroup)] = std::min(group, otherGroup);
+			}
+		}
+	}
+
+	// Groups that finished are regions of their own. Groups still running go back under the old
+	//  label: that is the rest of the region, or, if the search was cut short, several parts that
+	//  keep sharing it until `refineRegions()` separates them.
+	for (std::size_t i = 0; i < searchCount; ++i)
+		labelSize[findLabel(splitSearches[i].label)] = 0;
+	for (std::size_t i = 0; i < searchCount; ++i)
+		labelSize[findLabel(splitSearches[i].label)] += static_cast<int>(splitSearches[i].tiles.size());
+	for (std::size_t i = 0; i < searchCount; ++i)
+	{
+		const SplitSearch& search = splitSearches[i];
+		if (search.next != search.tiles.size())
+		{
+			int group = findLabel(search.label);
+			if (group != root)
+				labelParent[group] = root;
+		}
+	}
+	for (std::size_t i = 0; i < searchCount; ++i)
+	{
+		// The root of a group is its lowest label, which is one of its searches' own
+		SplitSearch& search = splitSearches[i];
+		if (findLabel(search.label) == search.label)
+			labelSize[root] -= labelSize[search.label];
+		search.tiles.clear();
+	}
+
+	if (isSplitOpen)
+		hasMergedRegions = true;
+}
+
+void CollisionGrid::refineRegions(int maxTiles)
+{
+	constexpr sf::Vector2i neighbors[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+	if (!hasMergedRegions)
+		return;
+
+	if (refineCursor < 0)
+	{
+		refineCursor = 0;
+		refineFirstLabel = static_cast<int>(labelParent.size());
+		refineLabel = -1;
+	}
+
+	const int tileCount = width * height;
+	for (int budget = maxTiles; budget > 0; --budget)
+	{
+		if (refineLabel < 0)
+		{
+			// Find the next tile no flood of this pass has reached yet
+			if (refineCursor == tileCount)
+			{
+				hasMergedRegions = false;
+				refineCursor = -1;
+				refineQueue.clear();
+				return;
+			}
+			int label = tileLabels[refineCursor];
+			if (label < 0 || label >= refineFirstLabel)
+			{
+				++refineCursor;
+				continue;
+			}
+
+			refineRoot = findLabel(label);
+			refineLabel = addLabel();
+			labelParent[refineLabel] = refineRoot;
+			tileLabels[refineCursor] = refineLabel;
+			refineQueue.assign(1, sf::Vector2i(refineCursor % width, refineCursor / width));
+			refineNext = 0;
+			continue;
+		}
+
+		if (refineNext == refineQueue.size())
+		{
+			// The flood reached every tile connected to where it started, so it is a region of its own
+			int size = static_cast<int>(refineQueue.size());
+			labelParent[refineLabel] = refineLabel;
+			labelSize[refineLabel] = size;
+			labelSize[refineRoot] -= size;
+			refineLabel = -1;
+			refineQueue.clear();
+			continue;
+		}
+
+		sf::Vector2i tile = refineQueue[refineNext++];
+		for (sf::Vector2i offset : neighbors)
+		{
+			sf::Vector2i neighbor = tile + offset;
+			if (!isWithinBounds(neighbor) || isSolid(neighbor))
+				continue;
+
+			int& label = tileLabels[static_cast<std::size_t>(neighbor.y) * width + neighbor.x];
+			if (label == refineLabel)
+				continue;
+			label = refineLabel;
+			refineQueue.push_back(neighbor);
+		}
+	}
+}
+
+void CollisionGrid::labelAllRegions()
+{
+	tileLabels.assign(static_cast<std::size_t>(width) * height, -1);
+	labelParent.clear();
+	labelSize.clear();
+	hasMergedRegions = false;
+	refineCursor = -1;
+	refineLabel = -1;
+	refineQueue.clear();
+
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = 0; x < width; ++x)
+		{
+			if (!isSolid(x, y) && tileLabels[static_cast<std::size_t>(y) * width + x] < 0)
+				floodRegion({ x, y }, addLabel());
+		}
+	}
+}
+
+void CollisionGrid::floodRegion(sf::Vector2i start, int label)
+{
+	constexpr sf::Vector2i neighbors[] = { { 1, 0 }, { -1, 0 }, { 0, 1 }, { 0, -1 } };
+
+	floodQueue.clear();
+	floodQueue.push_back(start);
+	tileLabels[static_cast<std::size_t>(start.y) * width + start.x] = label;
+
+	for (std::size_t i = 0; i < floodQueue.size(); ++i)
+	{
+		sf::Vector2i tile = floodQueue[i];
+		for (sf::Vector2i offset : neighbors)
+		{
+			sf::Vector2i neighbor = tile + offset;
+			if (!isWithinBounds(neighbor) || isSolid(neighbor))
+				continue;
+
+			int& neighborLabel = tileLabels[static_cast<std::size_t>(neighbor.y) * width + neighbor.x];
+			if (neighborLabel == label)
+				continue;
+			neighborLabel = label;
+			floodQueue.push_back(neighbor);
+		}
+	}
+	labelSize[label] = static_cast<int>(floodQueue.size());
+}
+
+bool CollisionGrid::isBypassable(int x, int y) const
+{
+	// The eight surrounding tiles in order around the ring, each orthogonally next to the one before
+	constexpr sf::Vector2i ring[] = { { 1, 0 }, { 1, 1 }, { 0, 1 }, { -1, 1 }, { -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 } };
+
+	// Count the runs of free ring tiles that hold an orthogonal neighbour; more than one means
+	//  the neighbours may only have been connected through this tile
+	int firstBlocked = -1;
+	for (int i = 0; i < 8; ++i)
+	{
+		if (!isWithinBounds(x + ring[i].x, y + ring[i].y) || isSolid(x + ring[i].x, y + ring[i].y))
+		{
+			firstBlocked = i;
+			break;
+		}
+	}
+	if (firstBlocked < 0)
+		return true; // The whole ring is free
+
+	int runsWithNeighbor = 0;
+	bool isInRun = false;
+	bool runHasNeighbor = false;
+	for (int step = 1; step <= 8; ++step)
+	{
+		int i = (firstBlocked + step) % 8;
+		bool isFree = isWithinBounds(x + ring[i].x, y + ring[i].y) && !isSolid(x + ring[i].x, y + ring[i].y);
+		if (isFree)
+		{
+			isInRun = true;
+			runHasNeighbor |= i % 2 == 0; // Even entries are the orthogonal neighbours
+		}
+		else if (isInRun)
+		{
+			runsWithNeighbor += runHasNeighbor;
+			isInRun = false;
+			runHasNeighbor = false;
+		}
+	}
+	return runsWithNeighbor <= 1;
+}
+
+int CollisionGrid::addLabel()
+{
+	int label = static_cast<int>(labelParent.size());
+	labelParent.push_back(label);
+	labelSize.push_back(1);
+	return label;
+}
+
+int CollisionGrid::findLabel(int label) const
+{
+	while (labelParent[label] != label)
+		label = labelParent[label];
+	return label;
+}
@@ -0,0 +1,183 @@
+// ================================================================================================
+// File: CollisionGrid.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the CollisionGrid class, which stores which tiles of a TileMap are solid.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// One bit per tile, set for solid tiles. Kept apart from the TileMap's tiles and render data
+//  so that it is cheap to copy, e.g. to hand pathfinding worker threads an immutable snapshot.
+// Also keeps a clearance value per tile (see `getClearance()`), so size-aware queries can
+//  replace a test over every tile a hitbox covers with a single lookup, and labels the regions
+//  of free tiles that are connected to each other (see `areConnected()`), so searches between
+//  regions can be rejected without exploring either of them. Finally, it caches which of its
+//  eight neighbours each tile can step to (see `getNeighborMask()`).
+class CollisionGrid
+{
+public:
+	CollisionGrid();
+	// Copies leave out the scratch buffers, which only hold anything during `applyChanges()`
+	CollisionGrid(const CollisionGrid& other);
+	CollisionGrid& operator=(const CollisionGrid& other);
+	CollisionGrid(CollisionGrid&& other) noexcept = default;
+	CollisionGrid& operator=(CollisionGrid&& other) noexcept = default;
+
+	// Resizes the grid, clearing every tile to not solid
+	void resize(int width, int height);
+	// Changes a tile. Its effect on clearance and regions is only applied by the next `applyChanges()`,
+	//  so many tiles can be set at once (e.g. when loading) without repeating work.
+	void setSolid(int x, int y, bool isSolid);
+	// Applies the tiles set since the last call to the clearance values, region labels and neighbour
+	//  masks, either around each of them or, if there are many, over the whole grid at once.
+	// Either way its cost depends on the number of changes, not on the size of the grid: a split
+	//  region is only relabelled as far as MAX_SPLIT_SEARCH_TILES reaches (see `areRegionsExact()`).
+	void applyChanges();
+	// Continues relabelling regions left sharing a label by a split, visiting at most `maxTiles`
+	//  tiles. Does nothing while `areRegionsExact()`. A full pass spans several calls, and starts
+	//  over if tiles change in between. Call regularly, e.g. once per fixed update.
+	void refineRegions(int maxTiles);
+
+	inline bool isSolid(int x, int y) const { return isWithinBounds(x, y) && (solidBits[static_cast<std::size_t>(y) * wordsPerRow + (x >> 6)] >> (x & 63)) & 1u; }
+	inline bool isSolid(sf::Vector2i coords) const { return isSolid(coords.x, coords.y); }
+	// Returns true if any tile inside the given (inclusive position, exclusive size) tile range is solid.
+	// The range is clipped to the grid, so tiles outside of it are NOT considered solid here;
+	//  callers that treat out-of-bounds as blocking must check that separately.
+	// Each row is tested 64 tiles at a time.
+	bool anySolidInRect(const sf::IntRect& tileRect) const;
+
+	// Chebyshev distance in tiles from this tile to the nearest solid tile or the edge of the map,
+	//  capped at MAX_CLEARANCE: 0 for solid (and out of bounds) tiles, 1 for free tiles next to one.
+	// Everything within `getClearance() - 1` tiles of the tile (in every direction) is free.
+	inline int getClearance(int x, int y) const { return isWithinBounds(x, y) ? clearance[static_cast<std::size_t>(y) * width + x] : 0; }
+	inline int getClearance(sf::Vector2i coords) const { return getClearance(coords.x, coords.y); }
+
+	// Label of the region of free tiles containing this tile, -1 for solid (and out of bounds) tiles.
+	// Regions are connected through free orthogonal neighbours, which is the same as connected by
+	//  8-way movement without cutting corners. Labels can change with every `applyChanges()` and
+	//  `refineRegions()`. Tiles with different labels are never connected; unless
+	//  `areRegionsExact()`, tiles with the same label may not be connected either.
+	int getRegion(int x, int y) const;
+	inline int getRegion(sf::Vector2i coords) const { return getRegion(coords.x, coords.y); }
+	// Returns true if both tiles are free and may be connected: always if a path between them
+	//  exists (for a mover of any size that fits on a single tile; larger movers may still be
+	//  blocked), and also for some that are not while `areRegionsExact()` is false
+	inline bool areConnected(sf::Vector2i a, sf::Vector2i b) const { int region = getRegion(a); return region >= 0 && region == getRegion(b); }
+	// False after a split that was too large to relabel right away, until `refineRegions()` has
+	//  finished relabelling. Until then some regions that were cut in two still share a label.
+	inline bool areRegionsExact() const { return !hasMergedRegions; }
+
+	// One bit per direction (see NEIGHBOR_OFFSETS) that can be stepped to from this tile: the tile
+	//  there is free, and for diagonals both tiles beside the step are free too (no corner cutting).
+	// Solid tiles have masks as well, for searches that start inside one. 0 out of bounds.
+	inline std::uint8_t getNeighborMask(int x, int y) const { return isWithinBounds(x, y) ? neighborMasks[static_cast<std::size_t>(y) * width + x] : 0; }
+	inline std::uint8_t getNeighborMask(sf::Vector2i coords) const { return getNeighborMask(coords.x, coords.y); }
+
+	inline bool isWithinBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
+	inline bool isWithinBounds(sf::Vector2i coords) const { return isWithinBounds(coords.x, coords.y); }
+	inline sf::Vector2i getSize() const { return sf::Vector2i(width, height); }
+	inline int getWidth() const { return width; }
+	inline int getHeight() const { return height; }
+
+	static constexpr int MAX_CLEARANCE = 8;
+	// Most tiles `applyChanges()` explores per region to find out how a split divided it
+	static constexpr int MAX_SPLIT_SEARCH_TILES = 4096;
+	// Direction of each bit of a neighbour mask, ordered by x and then y so that walking the bits
+	//  from the lowest up visits neighbours in the same order as two nested dx/dy loops
+	static constexpr int NEIGHBOR_OFFSETS[8][2] = { { -1, -1 }, { -1, 0 }, { -1, 1 }, { 0, -1 }, { 0, 1 }, { 1, -1 }, { 1, 0 }, { 1, 1 } };
+	static constexpr float NEIGHBOR_COSTS[8] = { 1.414f, 1.f, 1.414f, 1.f, 1.f, 1.414f, 1.f, 1.414f };
+
+	// Index of the lowest set bit of a (non-zero) neighbour mask
+	static inline int getLowestDirection(std::uint32_t mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long index;
+		_BitScanForward(&index, mask);
+		return static_cast<int>(index);
+#else
+		return __builtin_ctz(mask);
+#endif
+	}
+
+private:
+	// The smallest rectangle holding every pending change, grown by `margin` and clipped to the grid
+	sf::IntRect getChangedArea(int margin) const;
+
+	void updateClearance();
+	// Recomputes the clearance of the tiles inside `area` (clipped to the grid)
+	void computeClearance(const sf::IntRect& area);
+
+	void updateNeighborMasks();
+	// Recomputes the neighbour masks of the tiles inside `area` (clipped to the grid)
+	void computeNeighborMasks(const sf::IntRect& area);
+
+	void updateRegions();
+	// Separates the parts of region `root` that the tiles just made solid may have cut apart,
+	//  searching from `splitSeeds[firstSeed]` up to `splitSeeds[lastSeed]`, free tiles next to them
+	void splitRegion(int root, std::size_t firstSeed, std::size_t lastSeed);
+	void labelAllRegions();
+	// Gives every free tile connected to `start` the new label `label`
+	void floodRegion(sf::Vector2i start, int label);
+	// True if removing this (now solid) tile cannot have split its region, because its free
+	//  orthogonal neighbours are still connected around it through the eight tiles that surround it
+	bool isBypassable(int x, int y) const;
+	int addLabel();
+	int findLabel(int label) const;
+
+	int width;
+	int height;
+
+	// Each row starts on a new 64-bit word
+	std::vector<std::uint64_t> solidBits;
+	int wordsPerRow;
+
+	std::vector<std::uint8_t> clearance;
+	std::vector<std::uint8_t> clearanceScratch; // Scratch buffer for `computeClearance()`
+
+	// Each free tile has a label, and labels joined when regions merge point to a shared root label
+	//  (a union-find forest), so merging never has to relabel tiles. Only a split relabels the
+	//  tiles it affects, with new labels.
+	std::vector<int> tileLabels;  // Per tile, -1 for solid
+	std::vector<int> labelParent; // Per label, itself for root labels
+	std::vector<int> labelSize;   // Per root label, tiles in its region (for union by size)
+	std::vector<sf::Vector2i> floodQueue; // Scratch buffer for `floodRegion()`
+
+	// One breadth-first search of `splitRegion()`. All of them advance a tile at a time in turn, so
+	//  the parts that split off are found after exploring about as many tiles as the smaller
+	//  parts hold, rather than the whole region. Each has its own label, which also marks the
+	//  tiles it has reached; searches that meet share a root label.
+	struct SplitSearch
+	{
+		int label;
+		std::vector<sf::Vector2i> tiles; // Every tile reached, in the order they are expanded
+		std::size_t next;                // Index of the next tile in `tiles` to expand
+	};
+	std::vector<SplitSearch> splitSearches;
+	std::vector<std::pair<int, sf::Vector2i>> splitSeeds; // Scratch for `updateRegions()`, by region root
+
+	// Set when a split was given up on, which leaves the parts of the region sharing its label.
+	// `refineRegions()` then floods every region one at a time: a region being flooded gets a new
+	//  label that points to its old one until the flood is done, so queries see the old region.
+	bool hasMergedRegions;
+	int refineCursor;     // Next tile `refineRegions()` looks at, -1 while no pass is running
+	int refineFirstLabel; // Tiles with a label from here up were already flooded in this pass
+	int refineLabel;      // Label of the region being flooded, -1 if none
+	int refineRoot;       // The old root label it points to while the flood runs
+	std::size_t refineNext;
+	std::vector<sf::Vector2i> refineQueue;
+	std::vector<std::uint8_t> neighborMasks;
+
+	std::vector<sf::Vector2i> pendingChanges; // Tiles changed since the last `applyChanges()`
+};
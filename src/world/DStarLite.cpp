@@ -0,0 +1,474 @@
+// ================================================================================================
+// File: DStarLite.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <algorithm>
+#include <cstdlib>
+#include "DStarLite.hpp"
+
+using Pathfinding::DStarLite;
+
+namespace
+{
+	enum SubtreeMark : std::uint8_t
+	{
+		Unknown = 0,
+		Inside,
+		Outside,
+		Visiting
+	};
+}
+
+DStarLite::DStarLite() :
+	start(0, 0),
+	goal(0, 0),
+	requestedStart(0, 0),
+	requestedGoal(0, 0),
+	startIndex(0),
+	goalIndex(0),
+	width(0),
+	height(0),
+	keyModifier(0),
+	isInitialized(false),
+	areEndpointsValid(true),
+	syncedRevision(0)
+{
+}
+
+void DStarLite::setEndpoints(sf::Vector2i start, sf::Vector2i goal)
+{
+	requestedStart = start;
+	requestedGoal = goal;
+}
+
+int DStarLite::update(const TileMap& tileMap, int maxExpansions)
+{
+	const CollisionGrid& grid = tileMap.getCollisionGrid();
+
+	areEndpointsValid = grid.isWithinBounds(requestedStart) && grid.isWithinBounds(requestedGoal);
+	if (!areEndpointsValid)
+		return 0;
+
+	if (!isInitialized || grid.getWidth() != width || grid.getHeight() != height ||
+		!tileMap.getChangesSince(syncedRevision, changedTiles))
+	{
+		restart(grid);
+	}
+	else
+	{
+		// A tile changing can change every step into, out of, or diagonally past it
+		for (sf::Vector2i tile : changedTiles)
+		{
+			for (int y = std::max(tile.y - 1, 0); y <= std::min(tile.y + 1, height - 1); ++y)
+			{
+				for (int x = std::max(tile.x - 1, 0); x <= std::min(tile.x + 1, width - 1); ++x)
+					updateTile(grid, y * width + x);
+			}
+		}
+
+		if (requestedGoal != goal)
+		{
+			// Every queued key is now off by at most this much, which the km term absorbs
+			keyModifier += getHeuristic(goal, requestedGoal);
+			goal = requestedGoal;
+			goalIndex = goal.y * width + goal.x;
+		}
+
+		if (requestedStart != start)
+			moveStart(grid);
+	}
+	syncedRevision = tileMap.getRevision();
+
+	int expanded = 0;
+	while (expanded < maxExpansions && !isGoalSettled())
+	{
+		int current = heap.front();
+		Key oldKey = keys[current];
+		Key newKey = calculateKey(current);
+		++expanded;
+
+		if (oldKey < newKey)
+		{
+			// Queued before the goal moved, put it back with its real priority
+			heapUpdate(current, newKey);
+		}
+		else if (costFromStart[current] > lookaheadCost[current])
+		{
+			// Overconsistent: a cheaper route was found, settle it and offer it to the neighbours
+			costFromStart[current] = lookaheadCost[current];
+			heapRemove(current);
+
+			for (int dy = -1; dy <= 1; ++dy)
+			{
+				for (int dx = -1; dx <= 1; ++dx)
+				{
+					int x = current % width + dx;
+					int y = current / width + dy;
+					if ((dx == 0 && dy == 0) || x < 0 || x >= width || y < 0 || y >= height)
+						continue;
+
+					int neighbor = y * width + x;
+					Cost stepCost = getStepCost(grid, current, dx, dy);
+					if (stepCost == UNREACHABLE_COST)
+						continue;
+
+					Cost cost = costFromStart[current] + stepCost;
+					if (neighbor != startIndex && cost < lookaheadCost[neighbor])
+					{
+						touch(neighbor);
+						lookaheadCost[neighbor] = cost;
+						parent[neighbor] = current;
+						updateQueue(neighbor);
+					}
+				}
+			}
+		}
+		else
+		{
+			// Underconsistent: the route it had got more expensive, so everything that went through it
+			//  has to look for a new one
+			costFromStart[current] = UNREACHABLE_COST;
+			updateTile(grid, current);
+
+			for (int dy = -1; dy <= 1; ++dy)
+			{
+				for (int dx = -1; dx <= 1; ++dx)
+				{
+					int x = current % width + dx;
+					int y = current / width + dy;
+					if ((dx != 0 || dy != 0) && x >= 0 && x < width && y >= 0 && y < height)
+						updateTile(grid, y * width + x);
+				}
+			}
+		}
+	}
+	return expanded;
+}
+
+bool DStarLite::isFinished() const
+{
+	return !areEndpointsValid || (isInitialized && isGoalSettled());
+}
+
+bool DStarLite::getPath(std::vector<sf::Vector2i>& outPath) const
+{
+	outPath.clear();
+	if (!areEndpointsValid || !isFinished() || costFromStart[goalIndex] == UNREACHABLE_COST)
+		return false;
+
+	// Follow the parents back to the start. Bounded in case a repair left a cycle behind.
+	for (int index = goalIndex; index != startIndex; index = parent[index])
+	{
+		if (index == -1 || outPath.size() > touchedTiles.size())
+		{
+			outPath.clear();
+			return false;
+		}
+		outPath.emplace_back(index % width, index / width);
+	}
+	std::reverse(outPath.begin(), outPath.end());
+	return true;
+}
+
+void DStarLite::reset()
+{
+	isInitialized = false;
+	areEndpointsValid = true;
+}
+
+void DStarLite::restart(const CollisionGrid& grid)
+{
+	std::size_t tileCount = static_cast<std::size_t>(grid.getWidth()) * grid.getHeight();
+
+	if (grid.getWidth() != width || grid.getHeight() != height || costFromStart.size() != tileCount)
+	{
+		width = grid.getWidth();
+		height = grid.getHeight();
+		costFromStart.assign(tileCount, UNREACHABLE_COST);
+		lookaheadCost.assign(tileCount, UNREACHABLE_COST);
+		parent.assign(tileCount, -1);
+		keys.assign(tileCount, Key{ UNREACHABLE_COST, UNREACHABLE_COST });
+		heapPosition.assign(tileCount, -1);
+		isTouched.assign(tileCount, 0);
+		subtreeMark.assign(tileCount, Unknown);
+		touchedTiles.clear();
+	}
+	else
+	{
+		// Only clear what the last search used
+		for (int index : touchedTiles)
+		{
+			costFromStart[index] = UNREACHABLE_COST;
+			lookaheadCost[index] = UNREACHABLE_COST;
+			parent[index] = -1;
+			heapPosition[index] = -1;
+			isTouched[index] = 0;
+		}
+		touchedTiles.clear();
+	}
+	heap.clear();
+
+	start = requestedStart;
+	goal = requestedGoal;
+	startIndex = start.y * width + start.x;
+	goalIndex = goal.y * width + goal.x;
+	keyModifier = 0;
+
+	touch(startIndex);
+	lookaheadCost[startIndex] = 0;
+	updateQueue(startIndex);
+
+	isInitialized = true;
+}
+
+void DStarLite::moveStart(const CollisionGrid& grid)
+{
+	int newStartIndex = requestedStart.y * width + requestedStart.x;
+
+	// Costs below the new start stay valid up to a constant, anything else was measured
+	//  through the old start and has to go. If the new start was never reached there is
+	//  nothing worth keeping.
+	if (costFromStart[newStartIndex] == UNREACHABLE_COST)
+	{
+		restart(grid);
+		return;
+	}
+	start = requestedStart;
+	startIndex = newStartIndex;
+
+	std::vector<int>& removed = removedTiles;
+	removed.clear();
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < touchedTiles.size(); ++i)
+	{
+		int index = touchedTiles[i];
+		if (isInStartSubtree(index))
+		{
+			touchedTiles[kept++] = index;
+			continue;
+		}
+		costFromStart[index] = UNREACHABLE_COST;
+		lookaheadCost[index] = UNREACHABLE_COST;
+		parent[index] = -1;
+		if (heapPosition[index] != -1)
+			heapRemove(index);
+		isTouched[index] = 0;
+		removed.push_back(index);
+	}
+	touchedTiles.resize(kept);
+
+	for (int index : touchedTiles)
+		subtreeMark[index] = Unknown;
+	for (int index : removed)
+		subtreeMark[index] = Unknown;
+
+	lookaheadCost[startIndex] = costFromStart[startIndex];
+	parent[startIndex] = -1;
+	updateQueue(startIndex);
+
+	// Dropped tiles next to the kept branch become its new frontier
+	for (int index : removed)
+		updateTile(grid, index);
+}
+
+bool DStarLite::isInStartSubtree(int index)
+{
+	chain.clear();
+	SubtreeMark result = Outside;
+
+	for (int current = index; current != -1; current = parent[current])
+	{
+		if (subtreeMark[current] == Inside || subtreeMark[current] == Outside)
+		{
+			result = static_cast<SubtreeMark>(subtreeMark[current]);
+			break;
+		}
+		if (subtreeMark[current] == Visiting)
+			break; // Cycle, cannot lead to the start
+		if (current == startIndex)
+		{
+			result = Inside;
+			break;
+		}
+		subtreeMark[current] = Visiting;
+		chain.push_back(current);
+	}
+
+	for (int current : chain)
+		subtreeMark[current] = result;
+	return result == Inside;
+}
+
+void DStarLite::touch(int index)
+{
+	if (!isTouched[index])
+	{
+		isTouched[index] = 1;
+		touchedTiles.push_back(index);
+	}
+}
+
+DStarLite::Key DStarLite::calculateKey(int index) const
+{
+	Cost cost = std::min(costFromStart[index], lookaheadCost[index]);
+	if (cost == UNREACHABLE_COST)
+		return { UNREACHABLE_COST, UNREACHABLE_COST };
+
+	sf::Vector2i tile(index % width, index / width);
+	return { cost + getHeuristic(tile, goal) + keyModifier, cost };
+}
+
+DStarLite::Cost DStarLite::getHeuristic(sf::Vector2i a, sf::Vector2i b)
+{
+	// Same as octileHeuristic(), in the planner's integer units
+	int dx = std::abs(a.x - b.x);
+	int dy = std::abs(a.y - b.y);
+	return DIAGONAL_COST * std::min(dx, dy) + STRAIGHT_COST * std::abs(dx - dy);
+}
+
+DStarLite::Cost DStarLite::getStepCost(const CollisionGrid& grid, int from, int dx, int dy) const
+{
+	int x = from % width;
+	int y = from / width;
+
+	if (grid.isSolid(x + dx, y + dy))
+		return UNREACHABLE_COST;
+
+	bool isDiagonal = dx != 0 && dy != 0;
+	if (isDiagonal && (grid.isSolid(x + dx, y) || grid.isSolid(x, y + dy)))
+		return UNREACHABLE_COST; // Diagonal movement blocked by adjacent solid tile
+
+	return isDiagonal ? DIAGONAL_COST : STRAIGHT_COST;
+}
+
+void DStarLite::updateTile(const CollisionGrid& grid, int index)
+{
+	if (index != startIndex)
+	{
+		int x = index % width;
+		int y = index / width;
+		Cost best = UNREACHABLE_COST;
+		int bestParent = -1;
+
+		for (int dy = -1; dy <= 1; ++dy)
+		{
+			for (int dx = -1; dx <= 1; ++dx)
+			{
+				if ((dx == 0 && dy == 0) || x - dx < 0 || x - dx >= width || y - dy < 0 || y - dy >= height)
+					continue;
+
+				int neighbor = (y - dy) * width + (x - dx);
+				Cost stepCost = getStepCost(grid, neighbor, dx, dy);
+				if (costFromStart[neighbor] == UNREACHABLE_COST || stepCost == UNREACHABLE_COST)
+					continue;
+
+				Cost cost = costFromStart[neighbor] + stepCost;
+				if (cost < best)
+				{
+					best = cost;
+					bestParent = neighbor;
+				}
+			}
+		}
+		if (best != lookaheadCost[index] || bestParent != parent[index])
+			touch(index);
+		lookaheadCost[index] = best;
+		parent[index] = bestParent;
+	}
+	updateQueue(index);
+}
+
+void DStarLite::updateQueue(int index)
+{
+	if (costFromStart[index] != lookaheadCost[index])
+	{
+		touch(index);
+		if (heapPosition[index] == -1)
+			heapPush(index, calculateKey(index));
+		else
+			heapUpdate(index, calculateKey(index));
+	}
+	else if (heapPosition[index] != -1)
+		heapRemove(index);
+}
+
+bool DStarLite::isGoalSettled() const
+{
+	if (heap.empty())
+		return true;
+	return lookaheadCost[goalIndex] == costFromStart[goalIndex] && !(keys[heap.front()] < calculateKey(goalIndex));
+}
+
+void DStarLite::heapPush(int index, Key key)
+{
+	keys[index] = key;
+	heapPosition[index] = static_cast<int>(heap.size());
+	heap.push_back(index);
+	heapSiftUp(heap.size() - 1);
+}
+
+void DStarLite::heapRemove(int index)
+{
+	std::size_t position = static_cast<std::size_t>(heapPosition[index]);
+	heapSwap(position, heap.size() - 1);
+	heap.pop_back();
+	heapPosition[index] = -1;
+
+	if (position < heap.size())
+	{
+		heapSiftUp(position);
+		heapSiftDown(position);
+	}
+}
+
+void DStarLite::heapUpdate(int index, Key key)
+{
+	keys[index] = key;
+	std::size_t position = static_cast<std::size_t>(heapPosition[index]);
+	heapSiftUp(position);
+	heapSiftDown(static_cast<std::size_t>(heapPosition[index]));
+}
+
+void DStarLite::heapSiftUp(std::size_t position)
+{
+	while (position > 0)
+	{
+		std::size_t parentPosition = (position - 1) / 2;
+		if (!(keys[heap[position]] < keys[heap[parentPosition]]))
+			break;
+		heapSwap(position, parentPosition);
+		position = parentPosition;
+	}
+}
+
+void DStarLite::heapSiftDown(std::size_t position)
+{
+	while (true)
+	{
+		std::size_t smallest = position;
+		std::size_t left = 2 * position + 1;
+		std::size_t right = left + 1;
+
+		if (left < heap.size() && keys[heap[left]] < keys[heap[smallest]])
+			smallest = left;
+		if (right < heap.size() && keys[heap[right]] < keys[heap[smallest]])
+			smallest = right;
+		if (smallest == position)
+			break;
+
+		heapSwap(position, smallest);
+		position = smallest;
+	}
+}
+
+void DStarLite::heapSwap(std::size_t a, std::size_t b)
+{
+	std::swap(heap[a], heap[b]);
+	heapPosition[heap[a]] = static_cast<int>(a);
+	heapPosition[heap[b]] = static_cast<int>(b);
+}
@@ -0,0 +1,131 @@
+// ================================================================================================
+// File: DStarLite.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the DStarLite class, an incremental path planner that keeps its search
+//              between queries and only repairs the parts affected by what changed.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <limits>
+#include <SFML/System/Vector2.hpp>
+#include "TileMap.hpp"
+
+namespace Pathfinding
+{
+	// Lifelong planning A* from a start tile to a goal tile, where both may move between queries
+	//  (the moving target variant of D* Lite) and tiles may change.
+	// The search tree is kept and repaired instead of thrown away: a moved goal only shifts the
+	//  queue priorities (the km term), a moved start keeps the branch of the tree below the new
+	//  start and drops the rest, and a changed tile re-evaluates the 3x3 tiles around it. The cost
+	//  of a replan therefore depends on how much of the previous tree became invalid, not on the
+	//  length of the path.
+	// Uses the same movement rules and costs as `findPathAStar()`, and finds paths of the same cost.
+	class DStarLite
+	{
+	public:
+		DStarLite();
+
+		// Sets the endpoints of the next query. Nothing is searched until `update()`.
+		void setEndpoints(sf::Vector2i start, sf::Vector2i goal);
+
+		// Applies the map changes since the last call and continues the search, expanding at most
+		//  `maxExpansions` tiles. The search can be spread over several calls this way; `update()`
+		//  may be called with new endpoints or map changes in between.
+		// Returns the number of tiles expanded.
+		int update(const TileMap& tileMap, int maxExpansions);
+
+		// True once the search has settled for the endpoints and map seen by the last `update()`.
+		// False before the first `update()` and after `reset()`.
+		bool isFinished() const;
+		// Writes the tile-by-tile path (start excluded) into `outPath`.
+		// Returns false (with `outPath` left empty) if the search has not finished or there is no path.
+		bool getPath(std::vector<sf::Vector2i>& outPath) const;
+
+		// Forgets the search tree (but keeps the buffers), e.g. once the planner will not be
+		//  used for a while and repairing the old tree would cost more than starting over.
+		void reset();
+
+	private:
+		// Costs are kept as integers (thousandths of a straight step) so that the same route always
+		//  adds up to the same value however it was reached; with floats, rounding could leave a tile
+		//  that ties with the goal unexpanded and break the path.
+		using Cost = int;
+		static constexpr Cost STRAIGHT_COST = 1000;
+		static constexpr Cost DIAGONAL_COST = 1414;
+		static constexpr Cost UNREACHABLE_COST = std::numeric_limits<Cost>::max();
+
+		struct Key
+		{
+			Cost estimate; // min(g, rhs) + h + km
+			Cost cost;     // min(g, rhs)
+
+			inline bool operator<(const Key& other) const
+			{
+				return estimate < other.estimate || (estimate == other.estimate && cost < other.cost);
+			}
+		};
+
+		void restart(const CollisionGrid& grid);
+		void moveStart(const CollisionGrid& grid);
+		bool isInStartSubtree(int index);
+		void touch(int index);
+
+		Key calculateKey(int index) const;
+		static Cost getHeuristic(sf::Vector2i a, sf::Vector2i b);
+		Cost getStepCost(const CollisionGrid& grid, int from, int dx, int dy) const;
+		// Recomputes the lookahead cost (and parent) of a tile from its neighbours, then requeues it
+		void updateTile(const CollisionGrid& grid, int index);
+		// Puts a tile in the heap if it is inconsistent (g != rhs), takes it out otherwise
+		void updateQueue(int index);
+		bool isGoalSettled() const;
+
+		// Binary min-heap of tile indices, with each tile's position in it kept in `heapPosition`
+		//  so keys can be changed and tiles removed without searching for them
+		void heapPush(int index, Key key);
+		void heapRemove(int index);
+		void heapUpdate(int index, Key key);
+		void heapSiftUp(std::size_t position);
+		void heapSiftDown(std::size_t position);
+		void heapSwap(std::size_t a, std::size_t b);
+
+		// Per tile state, indexed by `y * width + x`.
+		// Costs are measured from the root of the search tree, which is not necessarily the current
+		//  start: after `moveStart()` they are all off by the same constant, which cancels out in
+		//  every comparison the search makes.
+		std::vector<Cost> costFromStart;   // g
+		std::vector<Cost> lookaheadCost;   // rhs, the best g of a neighbour plus the step from it
+		std::vector<int> parent;          // The neighbour `lookaheadCost` was taken from, -1 if none
+		std::vector<Key> keys;
+		std::vector<int> heapPosition;    // -1 if not in the heap
+		std::vector<int> heap;
+
+		// Tiles with any state set, so the search can be cleared or pruned without visiting the whole map
+		std::vector<int> touchedTiles;
+		std::vector<std::uint8_t> isTouched;
+		std::vector<std::uint8_t> subtreeMark; // Scratch for `moveStart()`
+		std::vector<int> chain;                // Scratch for `isInStartSubtree()`
+		std::vector<int> removedTiles;         // Scratch for `moveStart()`
+
+		sf::Vector2i start;
+		sf::Vector2i goal;
+		sf::Vector2i requestedStart;
+		sf::Vector2i requestedGoal;
+		int startIndex;
+		int goalIndex;
+		int width;
+		int height;
+		Cost keyModifier;  // km, the sum of heuristic distances the goal has moved
+
+		bool isInitialized;
+		bool areEndpointsValid; // Checked by `update()` and assumed until then, so an idle planner is not finished
+		std::uint64_t syncedRevision;
+		std::vector<sf::Vector2i> changedTiles; // Scratch buffer for `update()`
+	};
+}
@@ -0,0 +1,102 @@
+// ================================================================================================
+// File: FlowField.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <optional>
+#include "FlowField.hpp"
+#include "Pathfinding.hpp"
+
+using Pathfinding::FlowField;
+
+FlowField::FlowField() :
+	target(0, 0),
+	isDirty(true),
+	builtRevision(0)
+{
+}
+
+void FlowField::setTarget(sf::Vector2i target)
+{
+	if (target == this->target)
+		return;
+
+	this->target = target;
+	isDirty = true;
+}
+
+int FlowField::update(const TileMap& tileMap)
+{
+	if (!isDirty && builtRevision == tileMap.getRevision())
+		return 0;
+
+	rebuild(tileMap);
+	return bounds.size.x * bounds.size.y;
+}
+
+bool FlowField::getNextStep(const TileMap& tileMap, sf::Vector2i from, sf::Vector2i& outNext)
+{
+	update(tileMap);
+
+	if (getDistance(from) == UNREACHABLE || from == target)
+		return false;
+
+	// The distance of a tile is the smallest (neighbour distance + step cost) around it,
+	//  so stepping to the neighbour that gives that minimum follows a shortest path
+	float bestDistance = UNREACHABLE;
+	for (int dx = -1; dx <= 1; ++dx)
+	{
+		for (int dy = -1; dy <= 1; ++dy)
+		{
+			if (dx == 0 && dy == 0)
+				continue;
+
+			sf::Vector2i neighbor = from + sf::Vector2i(dx, dy);
+			if (!tileMap.isWithinBounds(neighbor) || tileMap.isSolid(neighbor))
+				continue;
+
+			bool isDiagonal = dx != 0 && dy != 0;
+			if (isDiagonal && (tileMap.isSolid(from.x + dx, from.y) || tileMap.isSolid(from.x, from.y + dy)))
+				continue;
+
+			float distance = getDistance(neighbor) + (isDiagonal ? 1.414f : 1.f);
+			if (distance < bestDistance)
+			{
+				bestDistance = distance;
+				outNext = neighbor;
+			}
+		}
+	}
+	return bestDistance != UNREACHABLE;
+}
+
+void FlowField::rebuild(const TileMap& tileMap)
+{
+	isDirty = false;
+	builtRevision = tileMap.getRevision();
+
+	sf::IntRect area(target - sf::Vector2i(RANGE, RANGE), sf::Vector2i(2 * RANGE + 1, 2 * RANGE + 1));
+	std::optional<sf::IntRect> clipped = area.findIntersection(sf::IntRect({ 0, 0 }, tileMap.getSize()));
+
+	// Like A*, never lead into a solid target (enemies would bounce around next to it)
+	if (!clipped || !clipped->contains(target) || tileMap.isSolid(target))
+	{
+		bounds = sf::IntRect();
+		distances.clear();
+		return;
+	}
+	bounds = *clipped;
+	computeDistanceField(tileMap.getCollisionGrid(), bounds, target, distances);
+}
+
+float FlowField::getDistance(sf::Vector2i tile) const
+{
+	if (!bounds.contains(tile))
+		return UNREACHABLE;
+
+	return distances[(tile.y - bounds.position.y) * bounds.size.x + (tile.x - bounds.position.x)];
+}
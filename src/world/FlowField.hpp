@@ -0,0 +1,59 @@
+// ================================================================================================
+// File: FlowField.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the FlowField class, a distance field towards a single target tile that
+//              any number of enemies can sample for their next step.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "TileMap.hpp"
+
+namespace Pathfinding
+{
+	// Holds the path distance from every tile within RANGE tiles of the target back to the target.
+	// The field is computed once (a single Dijkstra) and shared, so the cost of N enemies heading
+	//  for the same tile is one search plus an O(1) lookup per enemy, instead of N searches.
+	class FlowField
+	{
+	public:
+		FlowField();
+
+		// Sets the tile the field leads to. Nothing is computed until the field is next sampled.
+		void setTarget(sf::Vector2i target);
+		sf::Vector2i getTarget() const { return target; }
+
+		// Recomputes the field if the target or the map changed since it was last built.
+		// Returns how many tiles the rebuild covered, or 0 if the field was already up to date.
+		int update(const TileMap& tileMap);
+
+		// Writes the neighbour of `from` that lies on a shortest path to the target into `outNext`,
+		//  following the same movement rules as `findPathAStar()`.
+		// Calls `update()` first, so the field is always current.
+		// Returns false if `from` is the target, is outside the field, or cannot reach the target
+		//  without leaving the field; callers should fall back to a regular search in that case.
+		bool getNextStep(const TileMap& tileMap, sf::Vector2i from, sf::Vector2i& outNext);
+
+		// Half the width of the square area the field covers, in tiles
+		static constexpr int RANGE = 32;
+
+	private:
+		void rebuild(const TileMap& tileMap);
+		float getDistance(sf::Vector2i tile) const;
+
+		sf::Vector2i target;
+		sf::IntRect bounds;
+		std::vector<float> distances;
+
+		bool isDirty;
+		std::uint64_t builtRevision;
+	};
+}
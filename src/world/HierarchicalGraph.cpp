@@ -0,0 +1,560 @@
+// ================================================================================================
+// File: HierarchicalGraph.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include "HierarchicalGraph.hpp"
+#include "Pathfinding.hpp"
+
+using Pathfinding::HierarchicalGraph;
+
+namespace
+{
+	struct OpenEntry
+	{
+		float estimatedTotalCost;
+		float costFromStart;
+		int index;
+	};
+
+	struct CompareOpenEntries
+	{
+		bool operator()(const OpenEntry& a, const OpenEntry& b) const
+		{
+			return a.estimatedTotalCost > b.estimatedTotalCost;
+		}
+	};
+
+	// Per-thread scratch state for `HierarchicalGraph::findPath()`, stamped with a
+	//  generation like the A* buffers so it never has to be cleared.
+	struct AbstractSearchBuffers
+	{
+		std::vector<float> costFromStart;
+		std::vector<int> parent;
+		std::vector<std::uint32_t> visitedGeneration;
+		std::vector<OpenEntry> openSet;
+		std::uint32_t generation = 0;
+
+		std::vector<float> startDistances;
+		std::vector<float> goalDistances;
+		std::vector<int> waypoints;
+		std::vector<sf::Vector2i> segment;
+
+		void begin(std::size_t nodeCount)
+		{
+			if (visitedGeneration.size() < nodeCount)
+			{
+				costFromStart.resize(nodeCount);
+				parent.resize(nodeCount);
+				visitedGeneration.resize(nodeCount, 0);
+			}
+			openSet.clear();
+
+			if (++generation == 0)
+			{
+				std::fill(visitedGeneration.begin(), visitedGeneration.end(), 0);
+				generation = 1;
+			}
+		}
+		inline bool isVisited(int index) const { return visitedGeneration[index] == generation; }
+	};
+
+	thread_local AbstractSearchBuffers abstractBuffers;
+	thread_local std::vector<float> localDistances;
+}
+
+HierarchicalGraph::HierarchicalGraph() :
+	clusterCount(0, 0),
+	width(0),
+	isBuilt(false),
+	syncedRevision(0)
+{
+}
+
+HierarchicalGraph::HierarchicalGraph(const HierarchicalGraph& other) :
+	HierarchicalGraph()
+{
+	*this = other;
+}
+
+HierarchicalGraph& HierarchicalGraph::operator=(const HierarchicalGraph& other)
+{
+	if (this == &other)
+		return *this;
+
+	clusters = other.clusters;
+	nodeOffsets = other.nodeOffsets;
+	nodeTiles = other.nodeTiles;
+	nodePositions = other.nodePositions;
+	nodeClusters = other.nodeClusters;
+	partnerOffsets = other.partnerOffsets;
+	partnerNodes = other.partnerNodes;
+	clusterCount = other.clusterCount;
+	width = other.width;
+	isBuilt = other.isBuilt;
+	syncedRevision = other.syncedRevision;
+	return *this;
+}
+
+void HierarchicalGraph::update(const TileMap& tileMap)
+{
+	const CollisionGrid& grid = tileMap.getCollisionGrid();
+
+	if (isBuilt && tileMap.getRevision() == syncedRevision)
+		return;
+
+	changedTiles.clear();
+	if (!isBuilt || !tileMap.getChangesSince(syncedRevision, changedTiles))
+	{
+		rebuildAll(grid);
+		syncedRevision = tileMap.getRevision();
+		isBuilt = true;
+		return;
+	}
+	syncedRevision = tileMap.getRevision();
+
+	isClusterDirty.assign(clusters.size(), 0);
+
+	for (const sf::Vector2i& tile : changedTiles)
+	{
+		int clusterX = tile.x / CLUSTER_SIZE;
+		int clusterY = tile.y / CLUSTER_SIZE;
+		int localX = tile.x - clusterX * CLUSTER_SIZE;
+		int localY = tile.y - clusterY * CLUSTER_SIZE;
+		int index = clusterY * clusterCount.x + clusterX;
+
+		isClusterDirty[index] |= DIRTY_CLUSTER;
+
+		if (localX == CLUSTER_SIZE - 1 && clusterX + 1 < clusterCount.x)
+		{
+			isClusterDirty[index] |= DIRTY_EAST;
+			isClusterDirty[index + 1] |= DIRTY_CLUSTER;
+		}
+		if (localX == 0 && clusterX > 0)
+		{
+			isClusterDirty[index - 1] |= DIRTY_EAST | DIRTY_CLUSTER;
+		}
+		if (localY == CLUSTER_SIZE - 1 && clusterY + 1 < clusterCount.y)
+		{
+			isClusterDirty[index] |= DIRTY_SOUTH;
+			isClusterDirty[index + clusterCount.x] |= DIRTY_CLUSTER;
+		}
+		if (localY == 0 && clusterY > 0)
+		{
+			isClusterDirty[index - clusterCount.x] |= DIRTY_SOUTH | DIRTY_CLUSTER;
+		}
+	}
+
+	rebuildDirtyClusters(grid);
+}
+
+void HierarchicalGraph::rebuildAll(const CollisionGrid& grid)
+{
+	width = grid.getWidth();
+	clusterCount = { (grid.getWidth() + CLUSTER_SIZE - 1) / CLUSTER_SIZE, (grid.getHeight() + CLUSTER_SIZE - 1) / CLUSTER_SIZE };
+
+	// Empty clusters that only know their bounds, all rebuilt below
+	std::size_t count = static_cast<std::size_t>(clusterCount.x) * clusterCount.y;
+	clusters.assign(count, nullptr);
+	for (int y = 0; y < clusterCount.y; ++y)
+	{
+		for (int x = 0; x < clusterCount.x; ++x)
+		{
+			sf::Vector2i position(x * CLUSTER_SIZE, y * CLUSTER_SIZE);
+			sf::Vector2i size(std::min(CLUSTER_SIZE, grid.getWidth() - position.x), std::min(CLUSTER_SIZE, grid.getHeight() - position.y));
+			auto cluster = std::make_shared<Cluster>();
+			cluster->bounds = sf::IntRect(position, size);
+			clusters[y * clusterCount.x + x] = std::move(cluster);
+		}
+	}
+
+	isClusterDirty.assign(count, DIRTY_CLUSTER | DIRTY_EAST | DIRTY_SOUTH);
+	rebuildDirtyClusters(grid);
+}
+
+void HierarchicalGraph::rebuildDirtyClusters(const CollisionGrid& grid)
+{
+	// Borders first, since a cluster's entrances are taken from all four of its borders. The new
+	//  clusters go into `clusters` right away so their neighbours see their borders, and are
+	//  finished through `rebuiltClusters`, which nothing else can see.
+	rebuiltClusters.clear();
+	for (int i = 0; i < static_cast<int>(clusters.size()); ++i)
+	{
+		if (!isClusterDirty[i])
+			continue;
+
+		const Cluster& old = *clusters[i];
+		auto cluster = std::make_shared<Cluster>();
+		cluster->bounds = old.bounds;
+		if (!(isClusterDirty[i] & DIRTY_EAST))
+			cluster->eastTransitions = old.eastTransitions;
+		if (!(isClusterDirty[i] & DIRTY_SOUTH))
+			cluster->southTransitions = old.southTransitions;
+		rebuildBorders(grid, *cluster, i % clusterCount.x, i / clusterCount.x, isClusterDirty[i] & DIRTY_EAST, isClusterDirty[i] & DIRTY_SOUTH);
+
+		clusters[i] = cluster;
+		rebuiltClusters.push_back(std::move(cluster));
+	}
+
+	std::size_t next = 0;
+	for (int i = 0; i < static_cast<int>(clusters.size()); ++i)
+	{
+		if (isClusterDirty[i])
+			rebuildCluster(grid, i, *rebuiltClusters[next++]);
+	}
+	rebuiltClusters.clear();
+	rebuildNodeIds();
+}
+
+void HierarchicalGraph::rebuildBorders(const CollisionGrid& grid, Cluster& cluster, int clusterX, int clusterY, bool east, bool south) const
+{
+	const sf::IntRect& bounds = cluster.bounds;
+
+	if (east && clusterX + 1 < clusterCount.x)
+	{
+		sf::Vector2i first(bounds.position.x + bounds.size.x - 1, bounds.position.y);
+		computeBorderTransitions(grid, first, { 0, 1 }, { 1, 0 }, bounds.size.y, cluster.eastTransitions);
+	}
+	if (south && clusterY + 1 < clusterCount.y)
+	{
+		sf::Vector2i first(bounds.position.x, bounds.position.y + bounds.size.y - 1);
+		computeBorderTransitions(grid, first, { 1, 0 }, { 0, 1 }, bounds.size.x, cluster.southTransitions);
+	}
+}
+
+void HierarchicalGraph::computeBorderTransitions(const CollisionGrid& grid, sf::Vector2i first, sf::Vector2i step, sf::Vector2i across, int length, std::vector<Transition>& outTransitions) const
+{
+	outTransitions.clear();
+
+	auto addTransition = [&](int i)
+		{
+			sf::Vector2i a = first + step * i;
+			sf::Vector2i b = a + across;
+			outTransitions.push_back({ a.y * width + a.x, b.y * width + b.x });
+		};
+
+	int runStart = -1;
+	for (int i = 0; i <= length; ++i)
+	{
+		sf::Vector2i a = first + step * i;
+		bool isOpen = i < length && !grid.isSolid(a) && !grid.isSolid(a + across);
+
+		if (isOpen && runStart < 0)
+		{
+			runStart = i;
+		}
+		else if (!isOpen && runStart >= 0)
+		{
+			int runLength = i - runStart;
+			if (runLength <= MAX_SINGLE_ENTRANCE_LENGTH)
+			{
+				addTransition(runStart + runLength / 2);
+			}
+			else
+			{
+				addTransition(runStart);
+				addTransition(i - 1);
+			}
+			runStart = -1;
+		}
+	}
+}
+
+void HierarchicalGraph::rebuildCluster(const CollisionGrid& grid, int clusterIndex, Cluster& cluster) const
+{
+	cluster.nodes.clear();
+	cluster.partners.clear();
+
+	auto addNode = [&](int tile, int partner)
+		{
+			std::size_t node = std::find(cluster.nodes.begin(), cluster.nodes.end(), tile) - cluster.nodes.begin();
+			if (node == cluster.nodes.size())
+			{
+				cluster.nodes.push_back(tile);
+				cluster.partners.emplace_back();
+			}
+			cluster.partners[node].push_back(partner);
+		};
+
+	int clusterX = clusterIndex % clusterCount.x;
+	int clusterY = clusterIndex / clusterCount.x;
+
+	for (const Transition& transition : cluster.eastTransitions)
+		addNode(transition.first, transition.second);
+	for (const Transition& transition : cluster.southTransitions)
+		addNode(transition.first, transition.second);
+	if (clusterX > 0)
+	{
+		for (const Transition& transition : clusters[clusterIndex - 1]->eastTransitions)
+			addNode(transition.second, transition.first);
+	}
+	if (clusterY > 0)
+	{
+		for (const Transition& transition : clusters[clusterIndex - clusterCount.x]->southTransitions)
+			addNode(transition.second, transition.first);
+	}
+
+	// Costs are symmetric, so one search per node fills both halves of the matrix
+	std::size_t nodeCount = cluster.nodes.size();
+	cluster.costs.assign(nodeCount * nodeCount, Pathfinding::UNREACHABLE);
+	const int localWidth = cluster.bounds.size.x;
+
+	for (std::size_t i = 0; i < nodeCount; ++i)
+	{
+		sf::Vector2i source(cluster.nodes[i] % width, cluster.nodes[i] / width);
+		computeDistanceField(grid, cluster.bounds, source, localDistances);
+
+		for (std::size_t j = i; j < nodeCount; ++j)
+		{
+			int localX = cluster.nodes[j] % width - cluster.bounds.position.x;
+			int localY = cluster.nodes[j] / width - cluster.bounds.position.y;
+			float cost = localDistances[localY * localWidth + localX];
+			cluster.costs[i * nodeCount + j] = cost;
+			cluster.costs[j * nodeCount + i] = cost;
+		}
+	}
+}
+
+void HierarchicalGraph::rebuildNodeIds()
+{
+	nodeOffsets.resize(clusters.size());
+	nodeTiles.clear();
+	nodePositions.clear();
+	nodeClusters.clear();
+
+	for (std::size_t i = 0; i < clusters.size(); ++i)
+	{
+		nodeOffsets[i] = static_cast<int>(nodeTiles.size());
+		nodeTiles.insert(nodeTiles.end(), clusters[i]->nodes.begin(), clusters[i]->nodes.end());
+		for (int tile : clusters[i]->nodes)
+		{
+			nodePositions.emplace_back(tile % width, tile / width);
+			nodeClusters.push_back(static_cast<int>(i));
+		}
+	}
+
+	// Partners are stored as tiles, since a cluster's node order changes when it is rebuilt.
+	// The search wants ids, so they are looked up here once instead of on every expansion.
+	partnerOffsets.clear();
+	partnerNodes.clear();
+	for (std::size_t i = 0; i < clusters.size(); ++i)
+	{
+		for (const std::vector<int>& partners : clusters[i]->partners)
+		{
+			partnerOffsets.push_back(static_cast<int>(partnerNodes.size()));
+			for (int partner : partners)
+			{
+				int partnerCluster = getClusterIndex(partner % width, partner / width);
+				partnerNodes.push_back(nodeOffsets[partnerCluster] + findNode(partnerCluster, partner));
+			}
+		}
+	}
+	partnerOffsets.push_back(static_cast<int>(partnerNodes.size()));
+}
+
+int HierarchicalGraph::findNode(int clusterIndex, int tile) const
+{
+	const std::vector<int>& nodes = clusters[clusterIndex]->nodes;
+	for (std::size_t i = 0; i < nodes.size(); ++i)
+	{
+		if (nodes[i] == tile)
+			return static_cast<int>(i);
+	}
+	return -1;
+}
+
+std::size_t HierarchicalGraph::getNodeCount() const
+{
+	return nodeTiles.size();
+}
+
+void HierarchicalGraph::getEntrances(std::vector<Entrance>& outEntrances) const
+{
+	auto toCoords = [&](int tile) { return sf::Vector2i(tile % width, tile / width); };
+	auto isBefore = [](sf::Vector2i a, sf::Vector2i b) { return a.y != b.y ? a.y < b.y : a.x < b.x; };
+
+	outEntrances.clear();
+	for (const std::shared_ptr<const Cluster>& cluster : clusters)
+	{
+		const std::size_t nodeCount = cluster->nodes.size();
+		for (std::size_t i = 0; i < nodeCount; ++i)
+		{
+			Entrance entrance;
+			entrance.tile = toCoords(cluster->nodes[i]);
+			for (int partner : cluster->partners[i])
+				entrance.partners.push_back(toCoords(partner));
+			for (std::size_t j = 0; j < nodeCount; ++j)
+			{
+				float cost = cluster->costs[i * nodeCount + j];
+				if (j != i && cost != Pathfinding::UNREACHABLE)
+					entrance.costs.emplace_back(toCoords(cluster->nodes[j]), cost);
+			}
+			std::sort(entrance.partners.begin(), entrance.partners.end(), isBefore);
+			std::sort(entrance.costs.begin(), entrance.costs.end(), [&](const auto& a, const auto& b) { return isBefore(a.first, b.first); });
+			outEntrances.push_back(std::move(entrance));
+		}
+	}
+	std::sort(outEntrances.begin(), outEntrances.end(), [&](const Entrance& a, const Entrance& b) { return isBefore(a.tile, b.tile); });
+}
+
+bool HierarchicalGraph::findPath(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, int* outExpansions) const
+{
+	int ignoredExpansions = 0;
+	int& expansions = outExpansions ? *outExpansions : ignoredExpansions;
+
+	outPath.clear();
+	if (!isBuilt || !grid.isWithinBounds(start) || !grid.isWithinBounds(goal))
+		return false;
+	if (start == goal)
+		return true;
+	if (isUnreachable(grid, start, goal))
+		return false;
+	// A solid start tile has no entrances leading out of it, leave that (rare) case to plain A*
+	if (grid.isSolid(start))
+	{
+		expansions += grid.getWidth() * grid.getHeight();
+		return findPathAStar(grid, start, goal, outPath);
+	}
+
+	const int startCluster = getClusterIndex(start.x, start.y);
+	const int goalCluster = getClusterIndex(goal.x, goal.y);
+
+	auto getArea = [](const sf::IntRect& bounds) { return bounds.size.x * bounds.size.y; };
+
+	// A path that stays inside a single cluster never needs the abstract graph
+	if (startCluster == goalCluster)
+	{
+		expansions += getArea(clusters[startCluster]->bounds);
+		if (findPathAStar(grid, start, goal, clusters[startCluster]->bounds, outPath))
+			return true;
+	}
+
+	AbstractSearchBuffers& buffers = abstractBuffers;
+	computeDistanceField(grid, clusters[startCluster]->bounds, start, buffers.startDistances);
+	computeDistanceField(grid, clusters[goalCluster]->bounds, goal, buffers.goalDistances);
+	expansions += getArea(clusters[startCluster]->bounds) + getArea(clusters[goalCluster]->bounds);
+
+	auto getLocalDistance = [](const std::vector<float>& distances, const sf::IntRect& bounds, sf::Vector2i tile)
+		{
+			return distances[(tile.y - bounds.position.y) * bounds.size.x + (tile.x - bounds.position.x)];
+		};
+
+	// Abstract node ids: every entrance, followed by the start and the goal
+	const int nodeCount = static_cast<int>(nodeTiles.size());
+	const int startNode = nodeCount;
+	const int goalNode = nodeCount + 1;
+
+	buffers.begin(static_cast<std::size_t>(nodeCount) + 2);
+	CompareOpenEntries compare;
+
+	auto relax = [&](int node, int fromNode, float costFromStart)
+		{
+			if (buffers.isVisited(node) && costFromStart >= buffers.costFromStart[node])
+				return;
+
+			buffers.visitedGeneration[node] = buffers.generation;
+			buffers.costFromStart[node] = costFromStart;
+			buffers.parent[node] = fromNode;
+
+			float heuristic = node == goalNode ? 0.f : octileHeuristic(nodePositions[node], goal);
+			buffers.openSet.push_back({ costFromStart + heuristic, costFromStart, node });
+			std::push_heap(buffers.openSet.begin(), buffers.openSet.end(), compare);
+		};
+
+	buffers.visitedGeneration[startNode] = buffers.generation;
+	buffers.costFromStart[startNode] = 0.f;
+	buffers.parent[startNode] = -1;
+	buffers.openSet.push_back({ octileHeuristic(start, goal), 0.f, startNode });
+
+	bool isGoalFound = false;
+	while (!buffers.openSet.empty())
+	{
+		std::pop_heap(buffers.openSet.begin(), buffers.openSet.end(), compare);
+		OpenEntry current = buffers.openSet.back();
+		buffers.openSet.pop_back();
+
+		if (current.costFromStart > buffers.costFromStart[current.index])
+			continue;
+
+		++expansions;
+		if (current.index == goalNode)
+		{
+			isGoalFound = true;
+			break;
+		}
+
+		if (current.index == startNode)
+		{
+			const Cluster& cluster = *clusters[startCluster];
+			for (std::size_t j = 0; j < cluster.nodes.size(); ++j)
+			{
+				int node = nodeOffsets[startCluster] + static_cast<int>(j);
+				float distance = getLocalDistance(buffers.startDistances, cluster.bounds, nodePositions[node]);
+				if (distance != Pathfinding::UNREACHABLE)
+					relax(node, startNode, distance);
+			}
+			continue;
+		}
+
+		sf::Vector2i position = nodePositions[current.index];
+		int clusterIndex = nodeClusters[current.index];
+		const Cluster& cluster = *clusters[clusterIndex];
+		std::size_t localNode = static_cast<std::size_t>(current.index - nodeOffsets[clusterIndex]);
+		std::size_t clusterNodeCount = cluster.nodes.size();
+
+		const float* costs = &cluster.costs[localNode * clusterNodeCount];
+		for (std::size_t j = 0; j < clusterNodeCount; ++j)
+		{
+			if (j != localNode && costs[j] != Pathfinding::UNREACHABLE)
+				relax(nodeOffsets[clusterIndex] + static_cast<int>(j), current.index, current.costFromStart + costs[j]);
+		}
+
+		for (int i = partnerOffsets[current.index]; i < partnerOffsets[current.index + 1]; ++i)
+			relax(partnerNodes[i], current.index, current.costFromStart + 1.f);
+
+		if (clusterIndex == goalCluster)
+		{
+			float distance = getLocalDistance(buffers.goalDistances, cluster.bounds, position);
+			if (distance != Pathfinding::UNREACHABLE)
+				relax(goalNode, current.index, current.costFromStart + distance);
+		}
+	}
+
+	if (!isGoalFound)
+		return false;
+
+	// Collect the abstract waypoints from start to goal...
+	buffers.waypoints.clear();
+	for (int node = buffers.parent[goalNode]; node != startNode; node = buffers.parent[node])
+		buffers.waypoints.push_back(node);
+	std::reverse(buffers.waypoints.begin(), buffers.waypoints.end());
+
+	// ...and refine each leg. Legs inside a cluster are searched within that cluster only,
+	//  legs across a border are a single step.
+	sf::Vector2i from = start;
+	for (std::size_t i = 0; i <= buffers.waypoints.size(); ++i)
+	{
+		sf::Vector2i to = i < buffers.waypoints.size() ? nodePositions[buffers.waypoints[i]] : goal;
+		int fromCluster = getClusterIndex(from.x, from.y);
+
+		if (fromCluster != getClusterIndex(to.x, to.y))
+		{
+			outPath.push_back(to);
+		}
+		else
+		{
+			findPathAStar(grid, from, to, clusters[fromCluster]->bounds, buffers.segment);
+			expansions += getArea(clusters[fromCluster]->bounds);
+			outPath.insert(outPath.end(), buffers.segment.begin(), buffers.segment.end());
+		}
+		from = to;
+	}
+	return true;
+}
@@ -0,0 +1,130 @@
+// ================================================================================================
+// File: HierarchicalGraph.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the HierarchicalGraph class, an abstraction of the TileMap used for
+//              hierarchical pathfinding (HPA*) over long distances.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <utility>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "TileMap.hpp"
+
+namespace Pathfinding
+{
+	// Splits the map into CLUSTER_SIZE x CLUSTER_SIZE clusters. Wherever two neighbouring clusters
+	//  share an open stretch of border, one or two entrance tiles are placed on each side of it,
+	//  and the cost of travelling between every pair of entrances inside a cluster is precomputed.
+	// Long searches then run over the entrances only, and the result is refined back into tiles
+	//  one cluster at a time. Paths are near-optimal rather than optimal.
+	// A query across a 1024 x 512 map still takes around a millisecond: most of it is the abstract
+	//  search itself, which with the octile estimate pushes thousands of entrances onto its open
+	//  list before reaching the goal. It is several times cheaper than A* over the tiles, but not
+	//  microseconds.
+	class HierarchicalGraph
+	{
+	public:
+		HierarchicalGraph();
+		// Copies share the clusters (see `clusters`) and leave out the scratch buffers
+		HierarchicalGraph(const HierarchicalGraph& other);
+		HierarchicalGraph& operator=(const HierarchicalGraph& other);
+		HierarchicalGraph(HierarchicalGraph&& other) noexcept = default;
+		HierarchicalGraph& operator=(HierarchicalGraph&& other) noexcept = default;
+
+		// Brings the graph up to date with the map. Only clusters containing (or bordering)
+		//  tiles changed since the last call are rebuilt, using the map's change log.
+		void update(const TileMap& tileMap);
+
+		// Finds a path from `start` to `goal` through the abstract graph and refines it into
+		//  a tile-by-tile path with the same movement rules as `findPathAStar()`.
+		// `update()` must have been called since the map was last changed.
+		// Returns false (with `outPath` left empty) if no path is found.
+		// If `outExpansions` is given, the number of nodes the query expanded is added to it. Tile
+		//  searches confined to a cluster are counted as the whole cluster, so it may overestimate.
+		bool findPath(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, int* outExpansions = nullptr) const;
+
+		// Total number of entrance nodes in the graph
+		std::size_t getNodeCount() const;
+
+		// An entrance node as seen from outside the graph, with its links as tiles
+		struct Entrance
+		{
+			sf::Vector2i tile;
+			std::vector<sf::Vector2i> partners;                 // Entrances across a border it leads to
+			std::vector<std::pair<sf::Vector2i, float>> costs; // Other entrances of its cluster it can reach, and the cost
+		};
+		// Writes every entrance into `outEntrances`, each list ordered by tile (row by row), so two
+		//  graphs of the same map can be compared whatever order their clusters were built in.
+		void getEntrances(std::vector<Entrance>& outEntrances) const;
+
+		static constexpr int CLUSTER_SIZE = 16;
+		// Open border stretches up to this length get a single entrance in their middle,
+		//  longer ones get one at each end.
+		static constexpr int MAX_SINGLE_ENTRANCE_LENGTH = 6;
+
+	private:
+		// A pair of facing tiles (as `y * width + x` indices) on either side of a cluster border
+		struct Transition
+		{
+			int first;  // Tile in the left/top cluster
+			int second; // Tile in the right/bottom cluster
+		};
+
+		struct Cluster
+		{
+			sf::IntRect bounds;
+			std::vector<Transition> eastTransitions;  // Along its right border
+			std::vector<Transition> southTransitions; // Along its bottom border
+			std::vector<int> nodes;                 // Entrance tiles inside this cluster
+			std::vector<std::vector<int>> partners; // Per node, the tiles across a border it leads to
+			std::vector<float> costs;               // nodes.size() squared, INFINITY if unreachable
+		};
+
+		void rebuildAll(const CollisionGrid& grid);
+		// Replaces every cluster marked in `isClusterDirty` with a rebuilt one
+		void rebuildDirtyClusters(const CollisionGrid& grid);
+		void rebuildBorders(const CollisionGrid& grid, Cluster& cluster, int clusterX, int clusterY, bool east, bool south) const;
+		// Finds the entrances of `cluster` (at `clusterIndex`) and the costs between them. Its own
+		//  border transitions and those of its left and top neighbours must be up to date.
+		void rebuildCluster(const CollisionGrid& grid, int clusterIndex, Cluster& cluster) const;
+		void rebuildNodeIds();
+		void computeBorderTransitions(const CollisionGrid& grid, sf::Vector2i first, sf::Vector2i step, sf::Vector2i across, int length, std::vector<Transition>& outTransitions) const;
+
+		inline int getClusterIndex(int x, int y) const { return (y / CLUSTER_SIZE) * clusterCount.x + (x / CLUSTER_SIZE); }
+		int findNode(int clusterIndex, int tile) const;
+
+		// A cluster is never changed once built, a rebuilt one replaces it instead. Copies of the
+		//  graph (like the snapshots handed to path workers) can then share every cluster that has
+		//  not changed since, and copying the graph does not copy their cost matrices.
+		std::vector<std::shared_ptr<const Cluster>> clusters;
+		std::vector<int> nodeOffsets; // Per cluster, id of its first node in the abstract search
+		std::vector<int> nodeTiles;   // Per node id, its tile
+		std::vector<sf::Vector2i> nodePositions; // Per node id, its tile as coordinates
+		std::vector<int> nodeClusters;           // Per node id, the cluster it is in
+		// Per node id, the ids of the nodes across a border it leads to are
+		//  partnerNodes[partnerOffsets[id]] up to partnerNodes[partnerOffsets[id + 1]]
+		std::vector<int> partnerOffsets;
+		std::vector<int> partnerNodes;
+		sf::Vector2i clusterCount;
+		int width;
+
+		bool isBuilt;
+		std::uint64_t syncedRevision;
+		std::vector<sf::Vector2i> changedTiles;   // Scratch buffer for `update()`
+		std::vector<std::uint8_t> isClusterDirty; // Scratch buffer for `update()`, see the DIRTY_ flags
+		std::vector<std::shared_ptr<Cluster>> rebuiltClusters; // Scratch buffer for `rebuildDirtyClusters()`
+
+		static constexpr std::uint8_t DIRTY_CLUSTER = 1; // Entrances and costs need rebuilding
+		static constexpr std::uint8_t DIRTY_EAST = 2;    // Transitions along the east border need recomputing
+		static constexpr std::uint8_t DIRTY_SOUTH = 4;   // Transitions along the south border need recomputing
+	};
+}
@@ -0,0 +1,120 @@
+// ================================================================================================
+// File: LandmarkTable.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cmath>
+#include <algorithm>
+#include "LandmarkTable.hpp"
+
+using Pathfinding::LandmarkTable;
+using Pathfinding::LandmarkHeuristic;
+
+LandmarkTable::LandmarkTable() :
+	width(0),
+	height(0),
+	revision(0)
+{
+}
+
+void LandmarkTable::build(const CollisionGrid& grid, std::uint64_t revision, int landmarkCount)
+{
+	this->revision = revision;
+	width = grid.getWidth();
+	height = grid.getHeight();
+	landmarks.clear();
+	distances.clear();
+	scales.clear();
+
+	const std::size_t tileCount = static_cast<std::size_t>(width) * height;
+	const sf::IntRect bounds({ 0, 0 }, { width, height });
+	landmarkCount = std::clamp(landmarkCount, 0, MAX_LANDMARKS);
+
+	// Returns the free tile with the highest value, or (-1, -1) if there is no free tile
+	auto findFarthest = [&](const std::vector<float>& values)
+		{
+			sf::Vector2i farthest(-1, -1);
+			float farthestValue = -1.f;
+			for (std::size_t i = 0; i < tileCount; ++i)
+			{
+				int x = static_cast<int>(i % width);
+				int y = static_cast<int>(i / width);
+				if (values[i] > farthestValue && !grid.isSolid(x, y))
+				{
+					farthest = { x, y };
+					farthestValue = values[i];
+				}
+			}
+			return farthest;
+		};
+
+	// Landmarks work best at the edges of the map, so start from the tile farthest from an arbitrary one
+	std::vector<float> field;
+	std::vector<float> nearestLandmark(tileCount, UNREACHABLE);
+	sf::Vector2i next = findFarthest(nearestLandmark);
+	if (next.x < 0 || landmarkCount == 0)
+		return;
+	computeDistanceField(grid, bounds, next, field);
+	for (float& distance : field)
+	{
+		if (distance == UNREACHABLE)
+			distance = -1.f; // Only look inside the first tile's region
+	}
+	next = findFarthest(field);
+
+	std::vector<std::vector<std::uint16_t>> columns;
+	while (static_cast<int>(landmarks.size()) < landmarkCount)
+	{
+		computeDistanceField(grid, bounds, next, field);
+
+		float maxDistance = 0.f;
+		for (float distance : field)
+		{
+			if (distance != UNREACHABLE)
+				maxDistance = std::max(maxDistance, distance);
+		}
+		float scale = maxDistance > 0.f ? maxDistance / static_cast<float>(UNREACHABLE_DISTANCE - 1) : 1.f;
+
+		std::vector<std::uint16_t>& column = columns.emplace_back(tileCount);
+		for (std::size_t i = 0; i < tileCount; ++i)
+		{
+			if (field[i] == UNREACHABLE)
+			{
+				column[i] = UNREACHABLE_DISTANCE;
+				continue;
+			}
+			float units = std::floor(field[i] / scale);
+			column[i] = static_cast<std::uint16_t>(std::min(units, static_cast<float>(UNREACHABLE_DISTANCE - 1)));
+			nearestLandmark[i] = std::min(nearestLandmark[i], field[i]);
+		}
+		landmarks.push_back(next);
+		scales.push_back(scale);
+
+		// Tiles no landmark reaches count as infinitely far, so other regions get landmarks too
+		next = findFarthest(nearestLandmark);
+		if (next.x < 0 || nearestLandmark[next.y * width + next.x] == 0.f)
+			break; // Every free tile is a landmark already
+	}
+
+	// Interleave the columns so each tile's distances are next to each other
+	const std::size_t count = landmarks.size();
+	distances.resize(tileCount * count);
+	for (std::size_t landmark = 0; landmark < count; ++landmark)
+	{
+		for (std::size_t i = 0; i < tileCount; ++i)
+			distances[i * count + landmark] = columns[landmark][i];
+	}
+}
+
+LandmarkHeuristic::LandmarkHeuristic(const LandmarkTable& table, sf::Vector2i goal) :
+	table(&table),
+	landmarkCount(table.getLandmarkCount()),
+	goalDistances{}
+{
+	const std::uint16_t* distances = table.getDistances(goal.y * table.getWidth() + goal.x);
+	std::copy(distances, distances + landmarkCount, goalDistances.begin());
+}
@@ -0,0 +1,99 @@
+// ================================================================================================
+// File: LandmarkTable.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the LandmarkTable class, which stores distances from a few landmark tiles
+//              to every tile, and the LandmarkHeuristic A* can estimate with from them.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+#include "CollisionGrid.hpp"
+#include "Pathfinding.hpp"
+
+namespace Pathfinding
+{
+	// Distances from a handful of landmarks to every tile, for the ALT heuristic (A*, Landmarks,
+	//  Triangle inequality): no route between two tiles can be shorter than the difference of
+	//  their distances to any landmark. Unlike the straight-line estimates this accounts for walls,
+	//  so on maze-like maps it stays close to the real distance where the Euclidean one does not.
+	// Distances follow `Flying8` with any free tile open, so they are lower bounds for searches that
+	//  need more clearance too. They are only valid for the map they were built from, though.
+	class LandmarkTable
+	{
+	public:
+		LandmarkTable();
+
+		// Picks `landmarkCount` (at most MAX_LANDMARKS) landmarks spread over the map, each as far
+		//  from the ones before as possible, and measures the distance from each to every tile.
+		// Costs one Dijkstra over the whole map per landmark, so it is meant to run on a worker.
+		void build(const CollisionGrid& grid, std::uint64_t revision, int landmarkCount);
+
+		// Revision of the map the distances were measured on (see `TileMap::getRevision()`)
+		inline std::uint64_t getRevision() const { return revision; }
+		inline int getLandmarkCount() const { return static_cast<int>(landmarks.size()); }
+		inline const std::vector<sf::Vector2i>& getLandmarks() const { return landmarks; }
+		inline int getWidth() const { return width; }
+
+		// Quantised distances from every landmark to the tile at `index` (y * width + x)
+		inline const std::uint16_t* getDistances(int index) const { return distances.data() + static_cast<std::size_t>(index) * landmarks.size(); }
+		inline float getScale(int landmark) const { return scales[landmark]; }
+
+		// Stored in place of the distance to tiles a landmark cannot reach
+		static constexpr std::uint16_t UNREACHABLE_DISTANCE = 0xFFFF;
+		static constexpr int MAX_LANDMARKS = 16;
+
+	private:
+		int width;
+		int height;
+		std::uint64_t revision;
+		std::vector<sf::Vector2i> landmarks;
+		// Per tile, the distance to each landmark in units of that landmark's scale (rounded down),
+		//  so the table takes two bytes per landmark and tile. Tile-major, so one lookup reads a
+		//  single short run of memory.
+		std::vector<std::uint16_t> distances;
+		std::vector<float> scales; // Per landmark, the cost of one unit
+	};
+
+	// Heuristic rule for `findPathAStar<MoveRule, LandmarkHeuristic>()` that estimates with a
+	//  LandmarkTable, for a fixed goal. Never lower than `Octile`.
+	// Because the stored distances are rounded, each landmark's bound is lowered by one unit,
+	//  which keeps the estimate admissible.
+	class LandmarkHeuristic
+	{
+	public:
+		// `table` must outlive the heuristic and match the map searched
+		LandmarkHeuristic(const LandmarkTable& table, sf::Vector2i goal);
+
+		inline float estimate(sf::Vector2i from, sf::Vector2i goal) const
+		{
+			float bound = octileHeuristic(from, goal);
+			const std::uint16_t* fromDistances = table->getDistances(from.y * table->getWidth() + from.x);
+
+			for (int landmark = 0; landmark < landmarkCount; ++landmark)
+			{
+				int goalDistance = goalDistances[landmark];
+				int fromDistance = fromDistances[landmark];
+				if (goalDistance == LandmarkTable::UNREACHABLE_DISTANCE || fromDistance == LandmarkTable::UNREACHABLE_DISTANCE)
+					continue;
+
+				int difference = std::abs(goalDistance - fromDistance) - 1;
+				if (difference > 0)
+					bound = std::max(bound, static_cast<float>(difference) * table->getScale(landmark));
+			}
+			return bound;
+		}
+
+	private:
+		const LandmarkTable* table;
+		int landmarkCount;
+		std::array<std::uint16_t, LandmarkTable::MAX_LANDMARKS> goalDistances; // Looked up once per search
+	};
+}
@@ -0,0 +1,305 @@
+// ================================================================================================
+// File: Navigation.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cstdlib>
+#include <algorithm>
+#include "Navigation.hpp"
+#include "PathWorkerPool.hpp"
+#include "../core/Constants.hpp"
+
+Navigation::Navigation() :
+	snapshot(std::make_shared<Snapshot>()),
+	nextTask(0),
+	nodeBudgetLeft(0),
+	nodeDebt(0),
+	areLandmarksWanted(false)
+{
+}
+
+Navigation::~Navigation() = default;
+Navigation::Navigation(Navigation&& other) noexcept = default;
+Navigation& Navigation::operator=(Navigation&& other) noexcept = default;
+
+void Navigation::update(const TileMap& tileMap, sf::Vector2i playerTile, int nodeBudget)
+{
+	int repaid = std::min(nodeDebt, nodeBudget);
+	nodeDebt -= repaid;
+	nodeBudgetLeft = nodeBudget - repaid;
+
+	// Refined region labels do not change the revision, but are worth handing to the workers too
+	const CollisionGrid& grid = tileMap.getCollisionGrid();
+	if (snapshot->revision != tileMap.getRevision() || snapshot->grid.areRegionsExact() != grid.areRegionsExact())
+	{
+		// Workers may still be reading the old snapshot, so it is left alone and the new one starts
+		//  from a copy of its hierarchy (sharing every cluster), which is then updated with only the
+		//  changed tiles. The snapshot before it is copied into if no search holds it any more, so
+		//  the copy reuses its buffers instead of allocating new ones.
+		std::shared_ptr<Snapshot> next = spareSnapshot && spareSnapshot.use_count() == 1 ? std::move(spareSnapshot) : std::make_shared<Snapshot>();
+		next->grid = grid;
+		next->hierarchy = snapshot->hierarchy;
+		next->hierarchy.update(tileMap);
+		next->revision = tileMap.getRevision();
+		spareSnapshot = std::move(snapshot);
+		snapshot = std::move(next);
+	}
+
+	if (landmarkBuild && landmarkBuild->isDone)
+	{
+		landmarks = std::move(landmarkBuild->table);
+		landmarkBuild.reset();
+	}
+	// One build at a time; edits made while it runs are picked up by the next one
+	if (areLandmarksWanted && !landmarkBuild && !getCurrentLandmarks())
+		startLandmarkBuild();
+
+	for (Pathfinding::PlatformGraph& graph : platformGraphs)
+		graph.update(tileMap);
+
+	playerField.setTarget(playerTile);
+}
+
+bool Navigation::findPath(sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, Pathfinding::Algorithm algorithm, int minClearance) const
+{
+	return findPath(*snapshot, start, goal, outPath, algorithm, minClearance, getCurrentLandmarks());
+}
+
+bool Navigation::findPath(const Snapshot& snapshot, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, Pathfinding::Algorithm algorithm, int minClearance,
+	const Pathfinding::LandmarkTable* landmarks, int* outExpansions)
+{
+	if (isLongQuery(start, goal, algorithm, minClearance, landmarks))
+		return snapshot.hierarchy.findPath(snapshot.grid, start, goal, outPath, outExpansions);
+
+	return Pathfinding::findPath(snapshot.grid, start, goal, outPath, algorithm, minClearance, landmarks);
+}
+
+bool Navigation::isLongQuery(sf::Vector2i start, sf::Vector2i goal, Pathfinding::Algorithm algorithm, int minClearance, const Pathfinding::LandmarkTable* landmarks)
+{
+	if (minClearance > 1 || (algorithm == Pathfinding::Algorithm::AStarLandmarks && landmarks))
+		return false;
+	return std::abs(goal.x - start.x) > HIERARCHICAL_SEARCH_DISTANCE || std::abs(goal.y - start.y) > HIERARCHICAL_SEARCH_DISTANCE;
+}
+
+std::shared_ptr<Pathfinding::PathRequest> Navigation::requestPath(sf::Vector2i start, sf::Vector2i goal, Pathfinding::Algorithm algorithm, int minClearance, int smoothingClearance)
+{
+	auto request = std::make_shared<Pathfinding::PathRequest>();
+	request->start = start;
+	request->goal = goal;
+	request->algorithm = algorithm;
+	request->minClearance = minClearance;
+	request->smoothingClearance = smoothingClearance;
+	request->mapRevision = snapshot->revision;
+
+	if (algorithm == Pathfinding::Algorithm::AStarLandmarks)
+		areLandmarksWanted = true;
+
+	// Between regions there is nothing to search, answer right away without queueing anything
+	if (Pathfinding::isUnreachable(snapshot->grid, start, goal))
+	{
+		request->isDone = true;
+		return request;
+	}
+
+	// The task holds its own reference to the snapshot, so it stays valid however the map changes
+	auto task = std::make_shared<SearchTask>();
+	task->request = request;
+	task->snapshot = snapshot;
+	if (algorithm == Pathfinding::Algorithm::AStarLandmarks && getCurrentLandmarks())
+		task->landmarks = landmarks;
+
+	if (!isLongQuery(start, goal, algorithm, minClearance, task->landmarks.get()))
+	{
+		if (!spareSearches.empty())
+		{
+			task->search = std::move(spareSearches.back());
+			spareSearches.pop_back();
+		}
+		else
+			task->search = std::make_unique<Pathfinding::PathSearch>();
+
+		task->search->begin(snapshot->grid, start, goal, algorithm, minClearance, task->landmarks.get());
+	}
+	tasks.push_back(std::move(task));
+	return request;
+}
+
+int Navigation::claimNodeBudget(int wanted)
+{
+	int granted = std::max(std::min(wanted, nodeBudgetLeft), 0);
+	nodeBudgetLeft -= granted;
+	return granted;
+}
+
+void Navigation::releaseNodeBudget(int unused)
+{
+	nodeBudgetLeft += std::max(unused, 0);
+}
+
+void Navigation::chargeNodes(int nodes)
+{
+	nodeDebt += nodes - claimNodeBudget(nodes);
+}
+
+void Navigation::runSearches()
+{
+	using lv::Constants::PATHFINDING_NODES_PER_SEARCH;
+
+	// Retire searches that are finished, no longer wanted, or were started on an older map.
+	// The requester of an outdated search sees its old revision and asks again.
+	std::size_t kept = 0;
+	for (std::size_t i = 0; i < tasks.size(); ++i)
+	{
+		SearchTask& task = *tasks[i];
+		if (!task.isRunning)
+		{
+			chargeNodes(task.overspentNodes);
+			task.overspentNodes = 0;
+
+			if (task.snapshot->revision != snapshot->revision)
+				task.request->isDone = true;
+
+			if (task.request->isDone || task.request->isCancelled)
+			{
+				if (task.search)
+					spareSearches.push_back(std::move(task.search));
+				continue;
+			}
+		}
+		tasks[kept++] = std::move(tasks[i]);
+	}
+	tasks.resize(kept);
+
+	if (tasks.empty())
+		return;
+	Pathfinding::PathWorkerPool& workers = getWorkers();
+
+	nextTask %= tasks.size();
+	std::size_t visited = 0;
+	for (; visited < tasks.size() && nodeBudgetLeft > 0; ++visited)
+	{
+		std::shared_ptr<SearchTask> task = tasks[(nextTask + visited) % tasks.size()];
+		if (task->isRunning)
+			continue; // Its last slice has not finished yet
+
+		int slice = claimNodeBudget(PATHFINDING_NODES_PER_SEARCH);
+
+		task->isRunning = true;
+		workers.push([task, slice]() { runSlice(*task, slice); });
+	}
+	nextTask += visited;
+}
+
+void Navigation::runSlice(SearchTask& task, int maxExpansions)
+{
+	Pathfinding::PathRequest& request = *task.request;
+
+	if (!request.isCancelled)
+	{
+		if (!task.search)
+		{
+			// Long queries go through the hierarchical graph, which cannot be paused, in a single
+			//  slice. What it expands beyond the slice is charged by `runSearches()` once it is done.
+			int expansions = 0;
+			request.isFound = findPath(*task.snapshot, request.start, request.goal, request.path, request.algorithm, request.minClearance, task.landmarks.get(), &expansions);
+			task.overspentNodes = std::max(expansions - maxExpansions, 0);
+		}
+		else
+		{
+			// A slice of JPS can go over its budget by one jump point's scan, charged like the above
+			int expansions = task.search->advance(task.snapshot->grid, maxExpansions);
+			task.overspentNodes = std::max(expansions - maxExpansions, 0);
+			if (task.search->isFinished())
+			{
+				request.isFound = task.search->getStatus() == Pathfinding::PathSearch::Status::Found;
+				request.path.swap(task.search->getPath());
+			}
+		}
+
+		bool isFinished = !task.search || task.search->isFinished();
+		if (isFinished)
+		{
+			// Smoothed here rather than by the requester, so it also stays off the main thread
+			if (request.isFound && request.smoothingClearance > 0)
+				Pathfinding::smoothPath(task.snapshot->grid, request.start, request.path, request.smoothingClearance);
+			request.isDone = true;
+		}
+	}
+	task.isRunning = false;
+}
+
+bool Navigation::isCurrent(const Pathfinding::PathRequest& request) const
+{
+	return request.mapRevision == snapshot->revision;
+}
+
+const Pathfinding::LandmarkTable* Navigation::getCurrentLandmarks() const
+{
+	if (!landmarks || landmarks->getRevision() != snapshot->revision)
+		return nullptr;
+	return landmarks.get();
+}
+
+void Navigation::startLandmarkBuild()
+{
+	landmarkBuild = std::make_shared<LandmarkBuild>();
+	landmarkBuild->snapshot = snapshot;
+	landmarkBuild->table = std::make_shared<Pathfinding::LandmarkTable>();
+
+	std::shared_ptr<LandmarkBuild> build = landmarkBuild;
+	getLandmarkWorker().push([build]()
+		{
+			build->table->build(build->snapshot->grid, build->snapshot->revision, lv::Constants::PATHFINDING_LANDMARK_COUNT);
+			build->snapshot.reset();
+			build->isDone = true;
+		});
+}
+
+Pathfinding::PathWorkerPool& Navigation::getWorkers()
+{
+	if (!workers)
+		workers = std::make_unique<Pathfinding::PathWorkerPool>(lv::Constants::PATHFINDING_WORKER_COUNT);
+	return *workers;
+}
+
+Pathfinding::PathWorkerPool& Navigation::getLandmarkWorker()
+{
+	if (!landmarkWorker)
+		landmarkWorker = std::make_unique<Pathfinding::PathWorkerPool>(1);
+	return *landmarkWorker;
+}
+
+bool Navigation::getStepTowardsPlayer(const TileMap& tileMap, sf::Vector2i from, sf::Vector2i& outNext)
+{
+	chargeNodes(playerField.update(tileMap));
+	return playerField.getNextStep(tileMap, from, outNext);
+}
+
+void Navigation::updatePlayerVisibility(const TileMap& tileMap, sf::Vector2i playerEyeTile)
+{
+	playerVisibility.update(tileMap, playerEyeTile);
+}
+
+bool Navigation::canSeePlayerFrom(sf::Vector2i tile) const
+{
+	return playerVisibility.isVisible(tile);
+}
+
+bool Navigation::findWalkingPath(const TileMap& tileMap, const Pathfinding::JumpProfile& profile, sf::Vector2i start, sf::Vector2i goal, std::vector<Pathfinding::PlatformGraph::Step>& outPath)
+{
+	auto graph = std::find_if(platformGraphs.begin(), platformGraphs.end(),
+		[&profile](const Pathfinding::PlatformGraph& graph) { return graph.getProfile() == profile; });
+
+	if (graph == platformGraphs.end())
+	{
+		platformGraphs.emplace_back(profile);
+		graph = platformGraphs.end() - 1;
+	}
+	graph->update(tileMap);
+
+	return graph->findPath(start, goal, outPath);
+}
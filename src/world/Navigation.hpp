@@ -0,0 +1,155 @@
+// ================================================================================================
+// File: Navigation.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the Navigation class, which owns the pathfinding data derived from an
+//              Area's TileMap and is shared by all enemies in that Area.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <atomic>
+#include <SFML/System/Vector2.hpp>
+#include "TileMap.hpp"
+#include "CollisionGrid.hpp"
+#include "Pathfinding.hpp"
+#include "HierarchicalGraph.hpp"
+#include "FlowField.hpp"
+#include "PlatformGraph.hpp"
+#include "LandmarkTable.hpp"
+#include "VisibilityField.hpp"
+
+namespace Pathfinding
+{
+	class PathWorkerPool;
+}
+
+class Navigation
+{
+public:
+	Navigation();
+	~Navigation();
+	Navigation(Navigation&& other) noexcept;
+	Navigation& operator=(Navigation&& other) noexcept;
+
+	// Brings all navigation data up to date with the map and the player's tile, and sets how many
+	//  nodes all path searches together may expand during this update. Work that went over the
+	//  budget of earlier updates is paid back out of it first.
+	// Call once per fixed update, before any enemy is updated.
+	void update(const TileMap& tileMap, sf::Vector2i playerTile, int nodeBudget);
+	// Takes up to `wanted` nodes out of this update's budget for a search run by the caller itself.
+	// Returns how many it may expand, which may be zero once the budget is spent.
+	int claimNodeBudget(int wanted);
+	// Gives back the part of a claim the caller's search did not expand, for the searches after it
+	void releaseNodeBudget(int unused);
+
+	// Finds a path from `start` to `goal` right away. Short queries use `algorithm` directly, long
+	//  ones go through the hierarchical graph so they do not have to explore most of the map.
+	// The hierarchical graph only knows about free tiles, so queries with a `minClearance` above 1
+	//  (see `Pathfinding::findPathAStar()`) always use `algorithm`. So do AStarLandmarks queries
+	//  while the landmark table is up to date, since the landmarks make long searches cheap too.
+	// The table is first built in the background after an AStarLandmarks request, and rebuilt after
+	//  every map change; until it is ready those queries run as plain A*.
+	bool findPath(sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, Pathfinding::Algorithm algorithm, int minClearance = 1) const;
+	// Queues the same search against a snapshot of the map as it is now. It is run a slice at a
+	//  time on the worker threads by `runSearches()`, so it may take several updates to finish.
+	// Poll the returned request's `isDone` on later updates, and check `isCurrent()` before
+	//  using the result, since the map may have changed while the search ran. Requests between
+	//  regions that are not connected at all are done (and not found) as soon as they are made.
+	// If `smoothingClearance` is above 0, the path is also smoothed with it on the worker (see `Pathfinding::smoothPath()`).
+	std::shared_ptr<Pathfinding::PathRequest> requestPath(sf::Vector2i start, sf::Vector2i goal, Pathfinding::Algorithm algorithm, int minClearance = 1, int smoothingClearance = 0);
+	// Hands the next slice of each queued search to the worker threads, using whatever is left of
+	//  this update's node budget (and at most PATHFINDING_NODES_PER_SEARCH per search). Searches
+	//  that do not get a turn this update go first on the next one.
+	// Long queries cannot be paused and run in a single slice; whatever they expand beyond it is
+	//  taken out of the following updates' budgets, so the budget holds on average, not per update.
+	// Call once per fixed update, after the enemies have made their requests.
+	void runSearches();
+	// Returns true if the request was searched against the current version of the map
+	bool isCurrent(const Pathfinding::PathRequest& request) const;
+
+	// Next step from `from` towards the player, read from a flow field shared by all enemies.
+	// Returns false if `from` is outside the field (or already on the player's tile).
+	// Rebuilding the field after the player moved is charged to the node budget.
+	bool getStepTowardsPlayer(const TileMap& tileMap, sf::Vector2i from, sf::Vector2i& outNext);
+
+	// Brings the field of tiles that can see the player's eye up to date, which is only recomputed
+	//  when the player moves to another tile or the map changes. Call once per fixed update, before
+	//  any enemy is updated.
+	void updatePlayerVisibility(const TileMap& tileMap, sf::Vector2i playerEyeTile);
+	// Returns true if the player's eye can be seen from `tile` (see `VisibilityField`).
+	// Tiles more than VisibilityField::RANGE away never can.
+	bool canSeePlayerFrom(sf::Vector2i tile) const;
+
+	// Finds a path for a walking enemy with the given abilities over the surfaces it can stand on.
+	// The graph for each profile is built on first use and then kept in sync with the map by `update()`.
+	bool findWalkingPath(const TileMap& tileMap, const Pathfinding::JumpProfile& profile, sf::Vector2i start, sf::Vector2i goal, std::vector<Pathfinding::PlatformGraph::Step>& outPath);
+
+	// Queries spanning more tiles than this (on either axis) use the hierarchical graph
+	static constexpr int HIERARCHICAL_SEARCH_DISTANCE = 2 * Pathfinding::HierarchicalGraph::CLUSTER_SIZE;
+
+private:
+	// Everything a search reads, copied from the map. A snapshot is never modified once it has
+	//  been made, since workers may be reading it; `update()` makes a new one for every revision,
+	//  only ever writing into one nothing else holds.
+	struct Snapshot
+	{
+		std::uint64_t revision = 0;
+		CollisionGrid grid;
+		Pathfinding::HierarchicalGraph hierarchy;
+	};
+	static bool findPath(const Snapshot& snapshot, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, Pathfinding::Algorithm algorithm, int minClearance,
+		const Pathfinding::LandmarkTable* landmarks, int* outExpansions = nullptr);
+	// Takes `nodes` out of this update's budget, and whatever it does not cover out of later ones
+	void chargeNodes(int nodes);
+	// True if the query should go through the hierarchical graph
+	static bool isLongQuery(sf::Vector2i start, sf::Vector2i goal, Pathfinding::Algorithm algorithm, int minClearance, const Pathfinding::LandmarkTable* landmarks);
+	// The landmark table if it was built from the current snapshot, null otherwise
+	const Pathfinding::LandmarkTable* getCurrentLandmarks() const;
+	// Starts rebuilding the landmark table from the current snapshot on its own thread
+	void startLandmarkBuild();
+	Pathfinding::PathWorkerPool& getWorkers();
+	Pathfinding::PathWorkerPool& getLandmarkWorker();
+
+	// A queued search and the snapshot it runs against. At most one slice of it runs at a time,
+	//  and only the worker running that slice touches `search` while `isRunning` is set.
+	struct SearchTask
+	{
+		std::shared_ptr<Pathfinding::PathRequest> request;
+		std::shared_ptr<const Snapshot> snapshot;
+		std::unique_ptr<Pathfinding::PathSearch> search; // Null for long queries, see `runSlice()`
+		std::shared_ptr<const Pathfinding::LandmarkTable> landmarks; // Null unless the search estimates with it
+		std::atomic<bool> isRunning{ false };
+		int overspentNodes = 0; // Expanded beyond its slice (by a long query or a jump point), not yet charged
+	};
+	static void runSlice(SearchTask& task, int maxExpansions);
+
+	// A landmark table being built on the landmark worker. The main thread only touches `table` once `isDone` is set.
+	struct LandmarkBuild
+	{
+		std::shared_ptr<const Snapshot> snapshot;
+		std::shared_ptr<Pathfinding::LandmarkTable> table;
+		std::atomic<bool> isDone{ false };
+	};
+
+	std::shared_ptr<Snapshot> snapshot;
+	std::shared_ptr<Snapshot> spareSnapshot; // The one before `snapshot`, reused once no search holds it
+	std::vector<std::shared_ptr<SearchTask>> tasks;
+	std::vector<std::unique_ptr<Pathfinding::PathSearch>> spareSearches; // Kept so their buffers are reused
+	std::size_t nextTask; // Where the next round of slices starts, so every search gets a turn
+	int nodeBudgetLeft;   // Of this update's budget
+	int nodeDebt;         // Expanded beyond the budget of earlier updates, paid back by the next ones
+	std::unique_ptr<Pathfinding::PathWorkerPool> workers; // Started on first use, see `getWorkers()`
+	std::unique_ptr<Pathfinding::PathWorkerPool> landmarkWorker; // A single thread, so a build never holds up path searches
+	std::shared_ptr<const Pathfinding::LandmarkTable> landmarks; // Possibly built from an older snapshot
+	std::shared_ptr<LandmarkBuild> landmarkBuild; // Null while no build is running
+	bool areLandmarksWanted; // Set by the first AStarLandmarks request, no table is built before that
+	std::vector<Pathfinding::PlatformGraph> platformGraphs; // One per jump profile in use
+	Pathfinding::FlowField playerField; // Rebuilt lazily, only if someone samples it after the player moved
+	VisibilityField playerVisibility; // Shared by all enemies, so perception costs the same however many there are
+};
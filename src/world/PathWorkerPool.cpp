@@ -0,0 +1,60 @@
+// ================================================================================================
+// File: PathWorkerPool.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include "PathWorkerPool.hpp"
+
+using Pathfinding::PathWorkerPool;
+
+PathWorkerPool::PathWorkerPool(unsigned workerCount) :
+	isStopping(false)
+{
+	for (unsigned i = 0; i < workerCount; ++i)
+		workers.emplace_back(&PathWorkerPool::run, this);
+}
+
+PathWorkerPool::~PathWorkerPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		isStopping = true;
+		jobs.clear();
+	}
+	hasJobs.notify_all();
+
+	for (std::thread& worker : workers)
+		worker.join();
+}
+
+void PathWorkerPool::push(std::function<void()> job)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.push_back(std::move(job));
+	}
+	hasJobs.notify_one();
+}
+
+void PathWorkerPool::run()
+{
+	while (true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			hasJobs.wait(lock, [this] { return isStopping || !jobs.empty(); });
+
+			if (isStopping)
+				return;
+
+			job = std::move(jobs.front());
+			jobs.pop_front();
+		}
+		job();
+	}
+}
@@ -0,0 +1,47 @@
+// ================================================================================================
+// File: PathWorkerPool.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the PathWorkerPool class, a small set of threads that run queued path
+//              searches off the main thread.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+namespace Pathfinding
+{
+	// Runs jobs in the order they were pushed on `workerCount` threads.
+	// Jobs must only touch data they own or that nobody modifies while they run
+	//  (e.g. a map snapshot held through a shared pointer).
+	class PathWorkerPool
+	{
+	public:
+		explicit PathWorkerPool(unsigned workerCount);
+		// Drops any jobs that have not started yet and waits for the running ones to finish
+		~PathWorkerPool();
+
+		PathWorkerPool(const PathWorkerPool&) = delete;
+		PathWorkerPool& operator=(const PathWorkerPool&) = delete;
+
+		void push(std::function<void()> job);
+
+	private:
+		void run();
+
+		std::vector<std::thread> workers;
+		std::deque<std::function<void()>> jobs;
+		std::mutex mutex;
+		std::condition_variable hasJobs;
+		bool isStopping;
+	};
+}
@@ -11,165 +11,690 @@
 #include <cmath>
 #include <limits>
 #include <functional>
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <type_traits>
 #include "Pathfinding.hpp"
+#include "LandmarkTable.hpp"
 
-std::vector<sf::Vector2i> Pathfinding::getReachableNeighbors(const TileMap& map, const sf::Vector2i& tile)
+std::vector<sf::Vector2i> Pathfinding::getReachableNeighbors(const CollisionGrid& map, const sf::Vector2i& tile)
 {
 	std::vector<sf::Vector2i> neighbors;
+	Flying8::forEachNeighbor(map, tile, 1, [&](sf::Vector2i neighbor, float) { neighbors.push_back(neighbor); });
+	return neighbors;
+}
 
-	//switch (type)
-	//{
-	//case FlyingEnemy::Type::Walking:
-	//{
-	//	sf::Vector2i below(tile.x, tile.y + 1);
-	//	bool hasGroundBelow = map.isSolid(below);
-
-	//	// Standing on solid ground
-	//	if (hasGroundBelow)
-	//	{
-	//		// Walk left/right if destination and below are solid
-	//		for (int dx : {-1, 1})
-	//		{
-	//			sf::Vector2i side(tile.x + dx, tile.y);
-	//			sf::Vector2i sideBelow(side.x, side.y + 1);
-
-	//			if (!map.isSolid(side) && map.isSolid(sideBelow))
-	//				neighbors.push_back(side);
-	//		}
-
-	//		// Jump to tiles up-left, up, up-right (1 tile high)
-	//		for (int dx : {-1, 0, 1})
-	//		{
-	//			sf::Vector2i jumpTarget(tile.x + dx, tile.y - 1);
-	//			sf::Vector2i jumpBelow(jumpTarget.x, jumpTarget.y + 1);
-	//			sf::Vector2i jumpAbove(jumpTarget.x, jumpTarget.y - 1); // Assuming 2-tile high enemies
-
-	//			if (!map.isSolid(jumpTarget) && map.isSolid(jumpBelow) && !map.isSolid(jumpAbove))
-	//				neighbors.push_back(jumpTarget);
-	//		}
-
-	//		// Jump over small 1-tile-wide hole
-	//		for (int dx : {-2, 2})
-	//		{
-	//			sf::Vector2i target(tile.x + dx, tile.y);
-	//			sf::Vector2i targetBelow(target.x, target.y + 1);
-
-	//			sf::Vector2i mid(tile.x + dx / 2, tile.y);
-	//			sf::Vector2i midBelow(mid.x, mid.y + 1);
-
-	//			if (!map.isSolid(target) && map.isSolid(targetBelow) &&
-	//				!map.isSolid(mid) && !map.isSolid(midBelow))
-	//			{
-	//				neighbors.push_back(target);
-	//			}
-	//		}
-	//	}
-
-	//	// Allow drop down to one tile below if the target tile is walkable
-	//	sf::Vector2i oneBelow(tile.x, tile.y + 1);
-	//	sf::Vector2i twoBelow(tile.x, tile.y + 2);
-
-	//	if (!map.isSolid(oneBelow) && map.isSolid(twoBelow))
-	//	{
-	//		neighbors.push_back(oneBelow);
-	//	}
-	//	break;
-	//}
-	//case FlyingEnemy::Type::Flying:
-		for (int dx = -1; dx <= 1; ++dx)
+namespace
+{
+	struct OpenEntry
+	{
+		float estimatedTotalCost; // f cost = g + h
+		float costFromStart;      // g cost at the time the entry was pushed
+		int index;                // y * width + x
+	};
+
+	// Orders the open set as a min-heap on f cost (same ordering as std::greater on f)
+	struct CompareOpenEntries
+	{
+		bool operator()(const OpenEntry& a, const OpenEntry& b) const
 		{
-			for (int dy = -1; dy <= 1; ++dy)
+			return a.estimatedTotalCost > b.estimatedTotalCost;
+		}
+	};
+
+	// Dense per-tile search state. Instead of clearing the arrays between searches,
+	//  every tile is stamped with the generation of the search that last touched it,
+	//  and anything with an older stamp is treated as unvisited.
+	struct SearchBuffers
+	{
+		std::vector<float> costFromStart;
+		std::vector<int> parent;
+		std::vector<std::uint32_t> visitedGeneration;
+		std::vector<OpenEntry> openSet;
+		std::uint32_t generation = 0;
+
+		void begin(std::size_t tileCount)
+		{
+			if (visitedGeneration.size() < tileCount)
 			{
-				if (dx == 0 && dy == 0)
-					continue;
+				costFromStart.resize(tileCount);
+				parent.resize(tileCount);
+				visitedGeneration.resize(tileCount, 0);
+			}
+			openSet.clear();
 
-				sf::Vector2i neighbor = tile + sf::Vector2i(dx, dy);
+			if (++generation == 0) // Wrapped around, old stamps could collide
+			{
+				std::fill(visitedGeneration.begin(), visitedGeneration.end(), 0);
+				generation = 1;
+			}
+		}
+		inline bool isVisited(int index) const { return visitedGeneration[index] == generation; }
+	};
 
-				if (!map.isWithinBounds(neighbor) || map.isSolid(neighbor))
-					continue;
+	thread_local SearchBuffers buffers;
+
+	// Starts a new search in `state` with `start` as the only open tile
+	void beginSearch(SearchBuffers& state, const CollisionGrid& grid, sf::Vector2i start, float startHeuristic)
+	{
+		state.begin(static_cast<std::size_t>(grid.getWidth()) * grid.getHeight());
+
+		int startIndex = start.y * grid.getWidth() + start.x;
+		state.visitedGeneration[startIndex] = state.generation;
+		state.costFromStart[startIndex] = 0.f;
+		state.parent[startIndex] = -1;
+		state.openSet.push_back({ startHeuristic, 0.f, startIndex });
+	}
+
+	OpenEntry popOpenEntry(SearchBuffers& state)
+	{
+		std::pop_heap(state.openSet.begin(), state.openSet.end(), CompareOpenEntries());
+		OpenEntry entry = state.openSet.back();
+		state.openSet.pop_back();
+		return entry;
+	}
+
+	// Pushes every tile that `current` can step to by `MoveRule` inside `bounds` (tiles with at least
+	//  `minClearance`) and that this route reaches more cheaply than any route found before.
+	// Note: entries made stale by a cheaper route are still expanded (with their own g cost),
+	//  as they were with the old priority_queue version, so ties between equal-cost paths
+	//  are broken the same way and the returned path does not change.
+	template <typename MoveRule, typename HeuristicRule>
+	void expandAStar(SearchBuffers& state, const CollisionGrid& grid, const sf::IntRect& bounds, sf::Vector2i goal, int minClearance, const HeuristicRule& heuristic, const OpenEntry& current)
+	{
+		const int width = grid.getWidth();
+		sf::Vector2i position(current.index % width, current.index / width);
+
+		MoveRule::forEachNeighbor(grid, position, minClearance, [&](sf::Vector2i neighbor, float stepCost)
+			{
+				if (!bounds.contains(neighbor))
+					return;
+
+				float tentativeG = current.costFromStart + stepCost;
+				int neighborIndex = neighbor.y * width + neighbor.x;
+
+				if (!state.isVisited(neighborIndex) || tentativeG < state.costFromStart[neighborIndex])
+				{
+					state.visitedGeneration[neighborIndex] = state.generation;
+					state.costFromStart[neighborIndex] = tentativeG;
+					state.parent[neighborIndex] = current.index;
+
+					state.openSet.push_back({ tentativeG + heuristic.estimate(neighbor, goal), tentativeG, neighborIndex });
+					std::push_heap(state.openSet.begin(), state.openSet.end(), CompareOpenEntries());
+				}
+			});
+	}
+
+	// Walks the parent chain back to the start (which is not part of the path)
+	void buildAStarPath(const SearchBuffers& state, int width, int goalIndex, std::vector<sf::Vector2i>& outPath)
+	{
+		outPath.clear();
+		for (int index = goalIndex; state.parent[index] != -1; index = state.parent[index])
+			outPath.emplace_back(index % width, index / width);
+		std::reverse(outPath.begin(), outPath.end());
+	}
+}
+
+bool Pathfinding::isUnreachable(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal)
+{
+	if (start == goal)
+		return false;
+
+	int goalRegion = grid.getRegion(goal);
+	if (goalRegion < 0)
+		return true; // Solid or outside the map
+	return !grid.isSolid(start) && grid.getRegion(start) != goalRegion;
+}
+
+std::vector<sf::Vector2i> Pathfinding::findPathAStar(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal)
+{
+	std::vector<sf::Vector2i> path;
+	findPathAStar(grid, start, goal, path);
+	return path;
+}
+
+bool Pathfinding::findPathAStar(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, int minClearance)
+{
+	return findPathAStar(grid, start, goal, sf::IntRect({ 0, 0 }, grid.getSize()), outPath, minClearance);
+}
+
+bool Pathfinding::findPathAStar(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, const sf::IntRect& bounds, std::vector<sf::Vector2i>& outPath, int minClearance)
+{
+	return findPathAStar<Flying8, Euclidean>(grid, start, goal, bounds, outPath, minClearance);
+}
+
+template <typename MoveRule, typename HeuristicRule>
+bool Pathfinding::findPathAStar(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, const sf::IntRect& searchBounds, std::vector<sf::Vector2i>& outPath, int minClearance,
+	const HeuristicRule& heuristic)
+{
+	static_assert(!std::is_same_v<HeuristicRule, Manhattan> || !MoveRule::HAS_DIAGONAL_STEPS,
+		"Manhattan overestimates diagonal steps, so the path would not be the shortest; use Octile");
+
+	outPath.clear();
+
+	// isSolid() is false outside the map, so the bounds must not reach past it
+	std::optional<sf::IntRect> clippedBounds = searchBounds.findIntersection(sf::IntRect({ 0, 0 }, grid.getSize()));
+	if (!clippedBounds || !clippedBounds->contains(start) || !clippedBounds->contains(goal) || isUnreachable(grid, start, goal))
+		return false;
+	const sf::IntRect bounds = *clippedBounds;
+
+	const int width = grid.getWidth();
+	const int goalIndex = goal.y * width + goal.x;
+
+	beginSearch(buffers, grid, start, heuristic.estimate(start, goal));
+
+	while (!buffers.openSet.empty())
+	{
+		OpenEntry current = popOpenEntry(buffers);
+
+		if (current.index == goalIndex)
+		{
+			buildAStarPath(buffers, width, goalIndex, outPath);
+			return true;
+		}
+		expandAStar<MoveRule, HeuristicRule>(buffers, grid, bounds, goal, minClearance, heuristic, current);
+	}
+	return false; // No path found
+}
+
+// Every valid combination of the rules in Pathfinding.hpp (Manhattan needs a rule without diagonal steps)
+template bool Pathfinding::findPathAStar<Pathfinding::Flying8, Pathfinding::Euclidean>(const CollisionGrid&, sf::Vector2i, sf::Vector2i, const sf::IntRect&, std::vector<sf::Vector2i>&, int, const Pathfinding::Euclidean&);
+template bool Pathfinding::findPathAStar<Pathfinding::Flying8, Pathfinding::Octile>(const CollisionGrid&, sf::Vector2i, sf::Vector2i, const sf::IntRect&, std::vector<sf::Vector2i>&, int, const Pathfinding::Octile&);
+template bool Pathfinding::findPathAStar<Pathfinding::Walking, Pathfinding::Euclidean>(const CollisionGrid&, sf::Vector2i, sf::Vector2i, const sf::IntRect&, std::vector<sf::Vector2i>&, int, const Pathfinding::Euclidean&);
+template bool Pathfinding::findPathAStar<Pathfinding::Walking, Pathfinding::Octile>(const CollisionGrid&, sf::Vector2i, sf::Vector2i, const sf::IntRect&, std::vector<sf::Vector2i>&, int, const Pathfinding::Octile&);
+template bool Pathfinding::findPathAStar<Pathfinding::Flying8, Pathfinding::LandmarkHeuristic>(const CollisionGrid&, sf::Vector2i, sf::Vector2i, const sf::IntRect&, std::vector<sf::Vector2i>&, int, const Pathfinding::LandmarkHeuristic&);
+
+namespace
+{
+	inline int sign(int value) { return (value > 0) - (value < 0); }
+
+	// Jump and pruning rules for Jump Point Search on an 8-connected grid where a diagonal step
+	//  is only allowed if both orthogonal tiles next to it are free (same rule as A* above).
+	// With that rule a forced neighbour can only appear while moving straight, so diagonal jumps
+	//  stop wherever one of their two straight sub-jumps finds something.
+	struct JumpPointSearch
+	{
+		const CollisionGrid& grid;
+		sf::Vector2i goal;
+		int minClearance;
+		int scannedTiles = 0; // Tiles stepped onto by `jump()`, where most of the work of a search goes
+
+		// Clearance is 0 outside the map and for solid tiles, so this also covers the bounds check
+		inline bool isWalkable(int x, int y) const { return grid.getClearance(x, y) >= minClearance; }
+
+		// Steps from (x, y) in direction (dx, dy) until a jump point, the goal, or a dead end is hit.
+		// Returns true and writes the jump point into `outPoint` if one was found.
+		bool jump(int x, int y, int dx, int dy, sf::Vector2i& outPoint)
+		{
+			while (true)
+			{
+				x += dx;
+				y += dy;
+				++scannedTiles;
+
+				if (!isWalkable(x, y))
+					return false;
+
+				if (x == goal.x && y == goal.y)
+				{
+					outPoint = { x, y };
+					return true;
+				}
 
 				if (dx != 0 && dy != 0)
 				{
-					if (map.isSolid(tile + sf::Vector2i(dx, 0)) ||
-						map.isSolid(tile + sf::Vector2i(0, dy)))
+					sf::Vector2i ignored;
+					if (jump(x, y, dx, 0, ignored) || jump(x, y, 0, dy, ignored))
+					{
+						outPoint = { x, y };
+						return true;
+					}
+				}
+				else if (dx != 0)
+				{
+					// A tile above/below opens up that was blocked one step back
+					if ((isWalkable(x, y - 1) && !isWalkable(x - dx, y - 1)) ||
+						(isWalkable(x, y + 1) && !isWalkable(x - dx, y + 1)))
+					{
+						outPoint = { x, y };
+						return true;
+					}
+				}
+				else
+				{
+					if ((isWalkable(x - 1, y) && !isWalkable(x - 1, y - dy)) ||
+						(isWalkable(x + 1, y) && !isWalkable(x + 1, y - dy)))
 					{
-						continue; // Diagonal movement blocked by adjacent solid tile
+						outPoint = { x, y };
+						return true;
 					}
 				}
-				neighbors.push_back(neighbor);
+
+				// The next step must itself be a legal move (for diagonals: no corner cutting)
+				if (!isWalkable(x + dx, y) || !isWalkable(x, y + dy))
+					return false;
 			}
 		}
-		//break;
-	//}
-	return neighbors;
-}
 
-std::vector<sf::Vector2i> Pathfinding::reconstructPath(const std::unordered_map<sf::Vector2i, Node, Utility::Vector2iHasher>& cameFrom, sf::Vector2i current)
-{
-	std::vector<sf::Vector2i> path;
-	while (cameFrom.at(current).hasParent)
+		// Writes the directions worth jumping in from `tile`, given the direction it was reached from
+		//  (zero for the start tile, which tries every legal move). Returns the number of directions.
+		int getPrunedDirections(sf::Vector2i tile, int dx, int dy, sf::Vector2i (&outDirections)[8]) const
+		{
+			int count = 0;
+			auto add = [&](int ddx, int ddy) { outDirections[count++] = { ddx, ddy }; };
+
+			if (dx == 0 && dy == 0)
+			{
+				for (int ddx = -1; ddx <= 1; ++ddx)
+				{
+					for (int ddy = -1; ddy <= 1; ++ddy)
+					{
+						if ((ddx == 0 && ddy == 0) || !isWalkable(tile.x + ddx, tile.y + ddy))
+							continue;
+						if (ddx != 0 && ddy != 0 && (!isWalkable(tile.x + ddx, tile.y) || !isWalkable(tile.x, tile.y + ddy)))
+							continue;
+						add(ddx, ddy);
+					}
+				}
+			}
+			else if (dx != 0 && dy != 0)
+			{
+				bool canMoveX = isWalkable(tile.x + dx, tile.y);
+				bool canMoveY = isWalkable(tile.x, tile.y + dy);
+
+				if (canMoveX)
+					add(dx, 0);
+				if (canMoveY)
+					add(0, dy);
+				if (canMoveX && canMoveY && isWalkable(tile.x + dx, tile.y + dy))
+					add(dx, dy);
+			}
+			else if (dx != 0)
+			{
+				bool canMoveForward = isWalkable(tile.x + dx, tile.y);
+				bool canMoveUp = isWalkable(tile.x, tile.y - 1);
+				bool canMoveDown = isWalkable(tile.x, tile.y + 1);
+
+				if (canMoveForward)
+				{
+					add(dx, 0);
+					if (canMoveUp && isWalkable(tile.x + dx, tile.y - 1))
+						add(dx, -1);
+					if (canMoveDown && isWalkable(tile.x + dx, tile.y + 1))
+						add(dx, 1);
+				}
+				if (canMoveUp)
+					add(0, -1);
+				if (canMoveDown)
+					add(0, 1);
+			}
+			else
+			{
+				bool canMoveForward = isWalkable(tile.x, tile.y + dy);
+				bool canMoveLeft = isWalkable(tile.x - 1, tile.y);
+				bool canMoveRight = isWalkable(tile.x + 1, tile.y);
+
+				if (canMoveForward)
+				{
+					add(0, dy);
+					if (canMoveLeft && isWalkable(tile.x - 1, tile.y + dy))
+						add(-1, dy);
+					if (canMoveRight && isWalkable(tile.x + 1, tile.y + dy))
+						add(1, dy);
+				}
+				if (canMoveLeft)
+					add(-1, 0);
+				if (canMoveRight)
+					add(1, 0);
+			}
+			return count;
+		}
+	};
+
+	// Pushes the jump points reachable from `current`, using the direction it was reached from to prune
+	void expandJumpPoint(SearchBuffers& state, JumpPointSearch& jps, const OpenEntry& current)
 	{
-		path.push_back(current);
-		current = cameFrom.at(current).parent;
+		const int width = jps.grid.getWidth();
+		sf::Vector2i position(current.index % width, current.index / width);
+		int dx = 0, dy = 0;
+		if (state.parent[current.index] != -1)
+		{
+			int parentIndex = state.parent[current.index];
+			dx = sign(position.x - parentIndex % width);
+			dy = sign(position.y - parentIndex / width);
+		}
+
+		sf::Vector2i directions[8];
+		int directionCount = jps.getPrunedDirections(position, dx, dy, directions);
+		for (int i = 0; i < directionCount; ++i)
+		{
+			sf::Vector2i jumpPoint;
+			if (!jps.jump(position.x, position.y, directions[i].x, directions[i].y, jumpPoint))
+				continue;
+
+			float tentativeG = current.costFromStart + Pathfinding::octileHeuristic(position, jumpPoint);
+			int jumpIndex = jumpPoint.y * width + jumpPoint.x;
+
+			if (!state.isVisited(jumpIndex) || tentativeG < state.costFromStart[jumpIndex])
+			{
+				state.visitedGeneration[jumpIndex] = state.generation;
+				state.costFromStart[jumpIndex] = tentativeG;
+				state.parent[jumpIndex] = current.index;
+
+				state.openSet.push_back({ tentativeG + Pathfinding::octileHeuristic(jumpPoint, jps.goal), tentativeG, jumpIndex });
+				std::push_heap(state.openSet.begin(), state.openSet.end(), CompareOpenEntries());
+			}
+		}
 	}
-	std::reverse(path.begin(), path.end());
 
-	return path;
+	// Walks the jump points back to the start, filling in the straight or
+	//  diagonal run of tiles between each pair of them
+	void buildJumpPointPath(const SearchBuffers& state, int width, int goalIndex, std::vector<sf::Vector2i>& outPath)
+	{
+		outPath.clear();
+		for (int index = goalIndex; state.parent[index] != -1; index = state.parent[index])
+		{
+			sf::Vector2i point(index % width, index / width);
+			int parentIndex = state.parent[index];
+			sf::Vector2i parentPoint(parentIndex % width, parentIndex / width);
+			sf::Vector2i step(sign(parentPoint.x - point.x), sign(parentPoint.y - point.y));
+
+			for (; point != parentPoint; point += step)
+				outPath.push_back(point);
+		}
+		std::reverse(outPath.begin(), outPath.end());
+	}
 }
 
-std::vector<sf::Vector2i> Pathfinding::findPathAStar(const TileMap& tileMap, sf::Vector2i start, sf::Vector2i goal)
+void Pathfinding::computeDistanceField(const CollisionGrid& grid, const sf::IntRect& bounds, sf::Vector2i source, std::vector<float>& outDistances)
 {
-	using NodeMap = std::unordered_map<sf::Vector2i, Node, Utility::Vector2iHasher>;
+	thread_local std::vector<std::uint8_t> isOpen;
+	std::vector<OpenEntry>& openSet = buffers.openSet;
 
-	std::priority_queue<Node, std::vector<Node>, std::greater<Node>> openSet;
-	NodeMap cameFrom;
+	const int localWidth = bounds.size.x;
+	const int localHeight = bounds.size.y;
+	outDistances.assign(static_cast<std::size_t>(localWidth) * localHeight, UNREACHABLE);
+	openSet.clear();
 
-	auto hFunc = /*type == Enemy::Type::Flying ?*/ euclideanHeuristic /*: manhattanHeuristic*/;
+	if (!bounds.contains(source))
+		return;
 
-	Node startNode
+	// Copy the solidity inside the bounds once, the search below only looks at local tiles
+	isOpen.resize(outDistances.size());
+	std::uint8_t* open = isOpen.data(); // Hoisted so the loop below does not go through the thread_local wrapper
+	for (int y = 0; y < localHeight; ++y)
 	{
-		start,
-		0.f,
-		hFunc(start, goal)
-	};
-	openSet.emplace(startNode);
-	cameFrom[start] = startNode;
+		for (int x = 0; x < localWidth; ++x)
+			open[y * localWidth + x] = !grid.isSolid(bounds.position.x + x, bounds.position.y + y);
+	}
+	auto isOpenAt = [&](int x, int y) { return x >= 0 && x < localWidth && y >= 0 && y < localHeight && open[y * localWidth + x]; };
+
+	CompareOpenEntries compare;
+	int sourceIndex = (source.y - bounds.position.y) * localWidth + (source.x - bounds.position.x);
+	outDistances[sourceIndex] = 0.f;
+	openSet.push_back({ 0.f, 0.f, sourceIndex });
 
 	while (!openSet.empty())
 	{
-		Node current = openSet.top();
-		openSet.pop();
+		std::pop_heap(openSet.begin(), openSet.end(), compare);
+		OpenEntry current = openSet.back();
+		openSet.pop_back();
 
-		if (current.position == goal)
-			return reconstructPath(cameFrom, goal);
+		if (current.costFromStart > outDistances[current.index])
+			continue;
 
-		for (const auto& neighbor : getReachableNeighbors(tileMap, current.position))
+		int x = current.index % localWidth;
+		int y = current.index / localWidth;
+
+		for (int dx = -1; dx <= 1; ++dx)
 		{
-			float cost = 1.f;
-			//if (type == FlyingEnemy::Type::Flying)
-			//{
-				sf::Vector2i delta = neighbor - current.position;
-				cost = (delta.x != 0 && delta.y != 0) ? 1.414f : 1.f;
-			//}
+			for (int dy = -1; dy <= 1; ++dy)
+			{
+				if ((dx == 0 && dy == 0) || !isOpenAt(x + dx, y + dy))
+					continue;
 
-			float tentativeG = current.costFromStart + cost;
+				bool isDiagonal = dx != 0 && dy != 0;
+				if (isDiagonal && (!isOpenAt(x + dx, y) || !isOpenAt(x, y + dy)))
+					continue;
 
-			if (cameFrom.find(neighbor) == cameFrom.end() || tentativeG < cameFrom[neighbor].costFromStart)
-			{
-				auto h = hFunc(neighbor, goal);
+				float tentativeG = current.costFromStart + (isDiagonal ? 1.414f : 1.f);
+				int neighborIndex = (y + dy) * localWidth + (x + dx);
 
-				Node neighborNode
+				if (tentativeG < outDistances[neighborIndex])
 				{
-					neighbor,
-					tentativeG,
-					tentativeG + h,
-					current.position,
-					true
-				};
-				cameFrom[neighbor] = neighborNode;
-				openSet.emplace(neighborNode);
+					outDistances[neighborIndex] = tentativeG;
+					openSet.push_back({ tentativeG, tentativeG, neighborIndex });
+					std::push_heap(openSet.begin(), openSet.end(), compare);
+				}
 			}
 		}
 	}
-	return {}; // Return empty path if no path is found
-}
\ No newline at end of file
+}
+
+std::vector<sf::Vector2i> Pathfinding::findPathJPS(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal)
+{
+	std::vector<sf::Vector2i> path;
+	findPathJPS(grid, start, goal, path);
+	return path;
+}
+
+bool Pathfinding::findPathJPS(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, int minClearance)
+{
+	outPath.clear();
+	if (!grid.isWithinBounds(start) || !grid.isWithinBounds(goal) || isUnreachable(grid, start, goal))
+		return false;
+
+	const int width = grid.getWidth();
+	const int goalIndex = goal.y * width + goal.x;
+
+	JumpPointSearch jps{ grid, goal, minClearance };
+	beginSearch(buffers, grid, start, octileHeuristic(start, goal));
+
+	while (!buffers.openSet.empty())
+	{
+		OpenEntry current = popOpenEntry(buffers);
+
+		if (current.costFromStart > buffers.costFromStart[current.index])
+			continue; // Stale entry, a cheaper route to this jump point was found after it was pushed
+
+		if (current.index == goalIndex)
+		{
+			buildJumpPointPath(buffers, width, goalIndex, outPath);
+			return true;
+		}
+		expandJumpPoint(buffers, jps, current);
+	}
+	return false; // No path found
+}
+
+bool Pathfinding::hasClearLine(const CollisionGrid& grid, sf::Vector2i from, sf::Vector2i to, int minClearance)
+{
+	const int dx = std::abs(to.x - from.x);
+	const int dy = std::abs(to.y - from.y);
+	const int stepX = to.x > from.x ? 1 : -1;
+	const int stepY = to.y > from.y ? 1 : -1;
+
+	if (grid.getClearance(from) < minClearance)
+		return false;
+
+	// Visits every tile the line between the two centres crosses, in order. The line leaves the
+	//  current column after (1 + 2 * movedX) / (2 * dx) of its length and the current row after
+	//  (1 + 2 * movedY) / (2 * dy), whichever comes first; both are compared cross-multiplied.
+	int x = from.x;
+	int y = from.y;
+	int movedX = 0;
+	int movedY = 0;
+	while (movedX < dx || movedY < dy)
+	{
+		long long decision = static_cast<long long>(1 + 2 * movedX) * dy - static_cast<long long>(1 + 2 * movedY) * dx;
+		if (decision == 0)
+		{
+			// Exactly through a corner
+			if (grid.getClearance(x + stepX, y) < minClearance || grid.getClearance(x, y + stepY) < minClearance)
+				return false;
+			x += stepX;
+			y += stepY;
+			++movedX;
+			++movedY;
+		}
+		else if (decision < 0)
+		{
+			x += stepX;
+			++movedX;
+		}
+		else
+		{
+			y += stepY;
+			++movedY;
+		}
+
+		if (grid.getClearance(x, y) < minClearance)
+			return false;
+	}
+	return true;
+}
+
+void Pathfinding::smoothPath(const CollisionGrid& grid, sf::Vector2i start, std::vector<sf::Vector2i>& path, int minClearance)
+{
+	// Waypoints are compacted towards the front in place, `kept` of them so far
+	std::size_t kept = 0;
+	sf::Vector2i anchor = start;
+
+	for (std::size_t next = 0; next < path.size(); ++next)
+	{
+		// The waypoint right after the anchor is always reachable from it, it is the next step of
+		//  the original path. Skip ahead while the one after that can be reached directly too.
+		while (next + 1 < path.size() && hasClearLine(grid, anchor, path[next + 1], minClearance))
+			++next;
+
+		anchor = path[next];
+		path[kept++] = anchor;
+	}
+	path.resize(kept);
+}
+
+bool Pathfinding::findPath(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, Algorithm algorithm, int minClearance,
+	const LandmarkTable* landmarks)
+{
+	switch (algorithm)
+	{
+	case Algorithm::JumpPointSearch:
+		return findPathJPS(grid, start, goal, outPath, minClearance);
+	case Algorithm::AStarLandmarks:
+		if (landmarks && grid.isWithinBounds(goal))
+		{
+			const sf::IntRect bounds({ 0, 0 }, grid.getSize());
+			return findPathAStar<Flying8, LandmarkHeuristic>(grid, start, goal, bounds, outPath, minClearance, LandmarkHeuristic(*landmarks, goal));
+		}
+		return findPathAStar(grid, start, goal, outPath, minClearance);
+	case Algorithm::AStar:
+	default:
+		return findPathAStar(grid, start, goal, outPath, minClearance);
+	}
+}
+
+struct Pathfinding::PathSearch::State
+{
+	SearchBuffers buffers;
+	std::vector<sf::Vector2i> path;
+	sf::Vector2i goal;
+	int goalIndex = -1;
+	int minClearance = 1;
+	Algorithm algorithm = Algorithm::AStar;
+	std::optional<LandmarkHeuristic> landmarkHeuristic; // Set for AStarLandmarks searches given a table
+	Status status = Status::Idle;
+};
+
+Pathfinding::PathSearch::PathSearch() :
+	state(std::make_unique<State>())
+{
+}
+
+Pathfinding::PathSearch::~PathSearch() = default;
+Pathfinding::PathSearch::PathSearch(PathSearch&& other) noexcept = default;
+Pathfinding::PathSearch& Pathfinding::PathSearch::operator=(PathSearch&& other) noexcept = default;
+
+void Pathfinding::PathSearch::begin(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, Algorithm algorithm, int minClearance, const LandmarkTable* landmarks)
+{
+	state->path.clear();
+	state->goal = goal;
+	state->goalIndex = goal.y * grid.getWidth() + goal.x;
+	state->minClearance = minClearance;
+	state->algorithm = algorithm;
+	state->landmarkHeuristic.reset();
+
+	if (!grid.isWithinBounds(start) || !grid.isWithinBounds(goal) || isUnreachable(grid, start, goal))
+	{
+		state->status = Status::NotFound;
+		return;
+	}
+
+	float startHeuristic = algorithm == Algorithm::JumpPointSearch ? octileHeuristic(start, goal) : euclideanHeuristic(start, goal);
+	if (algorithm == Algorithm::AStarLandmarks && landmarks)
+	{
+		state->landmarkHeuristic.emplace(*landmarks, goal);
+		startHeuristic = state->landmarkHeuristic->estimate(start, goal);
+	}
+	beginSearch(state->buffers, grid, start, startHeuristic);
+	state->status = Status::Searching;
+}
+
+int Pathfinding::PathSearch::advance(const CollisionGrid& grid, int maxExpansions)
+{
+	SearchBuffers& buffers = state->buffers;
+	const int width = grid.getWidth();
+	const sf::IntRect bounds({ 0, 0 }, grid.getSize());
+	JumpPointSearch jps{ grid, state->goal, state->minClearance };
+
+	int expanded = 0;
+	while (state->status == Status::Searching && expanded < maxExpansions)
+	{
+		if (buffers.openSet.empty())
+		{
+			state->status = Status::NotFound;
+			break;
+		}
+		OpenEntry current = popOpenEntry(buffers);
+
+		if (state->algorithm == Algorithm::JumpPointSearch && current.costFromStart > buffers.costFromStart[current.index])
+			continue; // Stale entry, see findPathJPS()
+
+		if (current.index == state->goalIndex)
+		{
+			if (state->algorithm == Algorithm::JumpPointSearch)
+				buildJumpPointPath(buffers, width, state->goalIndex, state->path);
+			else
+				buildAStarPath(buffers, width, state->goalIndex, state->path);
+			state->status = Status::Found;
+			break;
+		}
+
+		if (state->algorithm == Algorithm::JumpPointSearch)
+		{
+			// A jump point costs as much as the tiles its jumps scanned, which on open ground can be
+			//  far more than A* would expand. It cannot be stopped halfway, so the last one may go over.
+			jps.scannedTiles = 0;
+			expandJumpPoint(buffers, jps, current);
+			expanded += std::max(jps.scannedTiles, 1);
+			continue;
+		}
+
+		if (state->landmarkHeuristic)
+			expandAStar<Flying8, LandmarkHeuristic>(buffers, grid, bounds, state->goal, state->minClearance, *state->landmarkHeuristic, current);
+		else
+			expandAStar<Flying8, Euclidean>(buffers, grid, bounds, state->goal, state->minClearance, Euclidean(), current);
+		++expanded;
+	}
+	return expanded;
+}
+
+Pathfinding::PathSearch::Status Pathfinding::PathSearch::getStatus() const
+{
+	return state->status;
+}
+
+std::vector<sf::Vector2i>& Pathfinding::PathSearch::getPath()
+{
+	return state->path;
+}
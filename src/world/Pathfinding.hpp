@@ -11,31 +11,90 @@
 #pragma once
 
 #include <vector>
-#include <unordered_map>
+#include <memory>
+#include <atomic>
+#include <cstdint>
+#include <algorithm>
+#include <limits>
 #include <SFML/System.hpp>
 #include "../core/Utility.hpp"
-#include "../state/game/enemies/FlyingEnemy.hpp"
+#include "CollisionGrid.hpp"
 
 namespace Pathfinding
 {
+	// Distance reported for tiles that cannot be reached
+	constexpr float UNREACHABLE = std::numeric_limits<float>::infinity();
+
 	enum class Heuristic
 	{
 		Manhattan,
 		Euclidean
 	};
 
-	struct Node
+	enum class Algorithm
+	{
+		AStar,
+		JumpPointSearch,
+		AStarLandmarks // A* estimating with a LandmarkTable, plain A* when none is given
+	};
+
+	class LandmarkTable;
+
+	// A search that can be run a few nodes at a time, so its cost can be spread over several updates.
+	// Gives the same paths as `findPath()` with the same algorithm. The grid passed to `advance()`
+	//  must be the one passed to `begin()`, unchanged. Search state is kept per object (not per
+	//  thread like the one-shot searches), so objects are meant to be reused between searches.
+	class PathSearch
+	{
+	public:
+		enum class Status
+		{
+			Idle,      // Nothing searched yet
+			Searching, // Started, call `advance()` again
+			Found,     // `getPath()` holds the result
+			NotFound
+		};
+
+		PathSearch();
+		~PathSearch();
+		PathSearch(PathSearch&& other) noexcept;
+		PathSearch& operator=(PathSearch&& other) noexcept;
+
+		// `landmarks` is only used by AStarLandmarks, and must stay alive until the search is finished
+		void begin(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, Algorithm algorithm, int minClearance = 1, const LandmarkTable* landmarks = nullptr);
+		// Expands nodes until `maxExpansions` is reached. For A* a node is a tile; for JPS every tile
+		//  the jumps from a jump point step onto counts, and since a jump point is expanded whole the
+		//  count can go over `maxExpansions` by that much.
+		// Returns the number of nodes actually expanded.
+		int advance(const CollisionGrid& grid, int maxExpansions);
+
+		Status getStatus() const;
+		inline bool isFinished() const { return getStatus() == Status::Found || getStatus() == Status::NotFound; }
+		// Tile-by-tile path (start excluded), empty unless the status is Found
+		std::vector<sf::Vector2i>& getPath();
+
+	private:
+		struct State;
+		std::unique_ptr<State> state;
+	};
+
+	// A path search handed to the worker threads (see `Navigation::requestPath()`).
+	// The requester keeps a shared pointer to it and polls `isDone`; the worker fills in
+	//  the other results before setting it.
+	struct PathRequest
 	{
-        sf::Vector2i position;
-        float costFromStart = 0.f; // g cost
-		float estimatedTotalCost = 0.f; // f cost = g + h
-        sf::Vector2i parent;
-        bool hasParent = false;
+		sf::Vector2i start;
+		sf::Vector2i goal;
+		Algorithm algorithm = Algorithm::AStar;
+		int minClearance = 1; // See `findPathAStar()`
+		int smoothingClearance = 0; // If above 0, the path found is passed through `smoothPath()` with it
+
+		std::uint64_t mapRevision = 0; // Revision of the map snapshot the search ran against
+		std::vector<sf::Vector2i> path;
+		bool isFound = false;
 
-        bool operator>(const Node& other) const
-        {
-            return estimatedTotalCost > other.estimatedTotalCost;
-        }
+		std::atomic<bool> isDone{ false };
+		std::atomic<bool> isCancelled{ false }; // Set by the requester if it no longer wants the result
 	};
 
 	inline float euclideanHeuristic(const sf::Vector2i& a, const sf::Vector2i& b)
@@ -48,12 +107,174 @@ namespace Pathfinding
 		return static_cast<float>(std::abs(a.x - b.x) + std::abs(a.y - b.y));
 	}
 
-	std::vector<sf::Vector2i> getReachableNeighbors(const TileMap& map, const sf::Vector2i& tile);
+	// Exact cost of the cheapest 8-connected route on an empty grid (diagonal steps cost 1.414)
+	inline float octileHeuristic(const sf::Vector2i& a, const sf::Vector2i& b)
+	{
+		int dx = std::abs(a.x - b.x);
+		int dy = std::abs(a.y - b.y);
+		return 1.414f * static_cast<float>(std::min(dx, dy)) + static_cast<float>(std::abs(dx - dy));
+	}
+
+	// ---- Search policies ----
+	// `findPathAStar<MoveRule, HeuristicRule>()` is specialised at compile time on how to move and
+	//  what to estimate, so every combination gets its own inner loop with both inlined into it.
+	// A heuristic rule has `float estimate(sf::Vector2i from, sf::Vector2i goal) const`. The searches
+	//  take it by instance, so a rule can carry data (see `LandmarkHeuristic`).
+	// `Manhattan` overestimates diagonal steps, so it may only be paired with a movement rule
+	//  without them (checked when the search is instantiated).
+	struct Manhattan
+	{
+		inline float estimate(sf::Vector2i from, sf::Vector2i goal) const { return manhattanHeuristic(from, goal); }
+	};
+	struct Euclidean
+	{
+		inline float estimate(sf::Vector2i from, sf::Vector2i goal) const { return euclideanHeuristic(from, goal); }
+	};
+	struct Octile
+	{
+		inline float estimate(sf::Vector2i from, sf::Vector2i goal) const { return octileHeuristic(from, goal); }
+	};
+
+	// A movement rule has `template <typename Visit> static void forEachNeighbor(const CollisionGrid& grid,
+	//  sf::Vector2i tile, int minClearance, Visit&& visit)`, which calls `visit(neighbor, stepCost)` for
+	//  every tile reachable from `tile` in one step. Only tiles with at least `minClearance` are open.
+	// Every step must be between orthogonally connected open tiles (diagonal steps through an open
+	//  corner tile), so that `isUnreachable()` holds for the rule. `HAS_DIAGONAL_STEPS` tells whether
+	//  any step moves along both axes at once.
+
+	// Moves in 8 directions, but never diagonally past a blocked tile. Diagonal steps cost 1.414.
+	struct Flying8
+	{
+		static constexpr bool HAS_DIAGONAL_STEPS = true;
+
+		template <typename Visit>
+		static inline void forEachNeighbor(const CollisionGrid& grid, sf::Vector2i tile, int minClearance, Visit&& visit)
+		{
+			if (minClearance <= 1)
+			{
+				// Any free tile will do, which the grid has already worked out for every tile
+				for (std::uint32_t mask = grid.getNeighborMask(tile); mask != 0; mask &= mask - 1)
+				{
+					int direction = CollisionGrid::getLowestDirection(mask);
+					visit(sf::Vector2i(tile.x + CollisionGrid::NEIGHBOR_OFFSETS[direction][0], tile.y + CollisionGrid::NEIGHBOR_OFFSETS[direction][1]),
+						CollisionGrid::NEIGHBOR_COSTS[direction]);
+				}
+				return;
+			}
+
+			for (int dx = -1; dx <= 1; ++dx)
+			{
+				for (int dy = -1; dy <= 1; ++dy)
+				{
+					if (dx == 0 && dy == 0)
+						continue;
+
+					sf::Vector2i neighbor(tile.x + dx, tile.y + dy);
+					if (grid.getClearance(neighbor) < minClearance)
+						continue;
+
+					bool isDiagonal = dx != 0 && dy != 0;
+					if (isDiagonal && (grid.getClearance(tile.x + dx, tile.y) < minClearance || grid.getClearance(tile.x, tile.y + dy) < minClearance))
+						continue; // Diagonal movement blocked by adjacent solid (or too cramped) tile
+
+					visit(neighbor, isDiagonal ? 1.414f : 1.f);
+				}
+			}
+		}
+	};
+
+	// Moves along the ground: on solid ground it can walk a tile sideways (also off a ledge), step
+	//  up onto a tile one higher, or jump over a hole one tile wide; in the air it can only fall.
+	// A simple tile-level walker; enemies with real jump arcs use `PlatformGraph` instead.
+	struct Walking
+	{
+		static constexpr bool HAS_DIAGONAL_STEPS = true; // Steps up onto a ledge
+
+		template <typename Visit>
+		static inline void forEachNeighbor(const CollisionGrid& grid, sf::Vector2i tile, int minClearance, Visit&& visit)
+		{
+			auto isOpen = [&](int x, int y) { return grid.getClearance(x, y) >= minClearance; };
+			const int x = tile.x;
+			const int y = tile.y;
+
+			if (!grid.isSolid(x, y + 1))
+			{
+				if (isOpen(x, y + 1))
+					visit(sf::Vector2i(x, y + 1), 1.f);
+				return;
+			}
+
+			for (int dx : { -1, 1 })
+			{
+				if (isOpen(x + dx, y))
+					visit(sf::Vector2i(x + dx, y), 1.f);
+
+				// Up past the corner of the step, so only with room above
+				if (isOpen(x, y - 1) && isOpen(x + dx, y - 1) && grid.isSolid(x + dx, y))
+					visit(sf::Vector2i(x + dx, y - 1), 1.414f);
+
+				if (isOpen(x + dx, y) && !grid.isSolid(x + dx, y + 1) && isOpen(x + 2 * dx, y) && grid.isSolid(x + 2 * dx, y + 1))
+					visit(sf::Vector2i(x + 2 * dx, y), 2.f);
+			}
+		}
+	};
 
-	std::vector<sf::Vector2i> reconstructPath(const std::unordered_map<sf::Vector2i, Node, Utility::Vector2iHasher>& cameFrom, sf::Vector2i current);
+	// Tiles a flyer can step to from `tile` (see `Flying8`)
+	std::vector<sf::Vector2i> getReachableNeighbors(const CollisionGrid& map, const sf::Vector2i& tile);
 
-	// Finds the shortest path from `start` to `goal` using the A* algorithm.
-	// The heuristic can be either Manhattan or Euclidean.
+	// Returns true if the grid's region labels already show that no search from `start` can reach
+	//  `goal` (see `CollisionGrid::areConnected()`). A solid start is never rejected, since the
+	//  searches can still step out of it. Checked by every search before it explores anything.
+	bool isUnreachable(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal);
+
+	// Finds the shortest path from `start` to `goal` using the A* algorithm, moving by `Flying8`
+	//  and estimating with `Euclidean`.
 	// Returns a vector of tile coordinates representing the path.
-	std::vector<sf::Vector2i> findPathAStar(const TileMap& tileMap, sf::Vector2i start, sf::Vector2i goal);
+	std::vector<sf::Vector2i> findPathAStar(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal);
+	// Same as above, but writes the path into `outPath`, reusing its capacity.
+	// Search state lives in per-thread buffers indexed by `y * width + x` that are
+	//  reused between calls, so repeated searches do not allocate once warmed up.
+	// Only tiles with at least `minClearance` (see `CollisionGrid::getClearance()`) are stepped on,
+	//  so larger movers can ask for room around the path; the default of 1 allows any free tile.
+	// Returns false (with `outPath` left empty) if no path is found.
+	bool findPathAStar(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, int minClearance = 1);
+	// Same as above, but the search never steps outside of the `bounds` tile rectangle
+	//  (used to refine hierarchical paths one cluster at a time).
+	bool findPathAStar(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, const sf::IntRect& bounds, std::vector<sf::Vector2i>& outPath, int minClearance = 1);
+	// The same search with any movement and heuristic rule (see "Search policies" above), e.g.
+	//  `findPathAStar<Walking, Octile>(...)`. Instantiated in Pathfinding.cpp for every valid
+	//  combination of the rules above; a new rule needs its instantiations added there.
+	template <typename MoveRule, typename HeuristicRule>
+	bool findPathAStar(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, const sf::IntRect& bounds, std::vector<sf::Vector2i>& outPath, int minClearance,
+		const HeuristicRule& heuristic = HeuristicRule());
+
+	// Finds a shortest path from `start` to `goal` using Jump Point Search.
+	// Uses the same movement rules as `findPathAStar()` (8-connected, no diagonal steps past
+	//  a solid tile) and returns a path of the same cost, but only pushes jump points onto the
+	//  open set instead of every tile, which makes long searches across open areas much cheaper.
+	// The jump points are expanded back into a tile-by-tile path, so callers can use either.
+	std::vector<sf::Vector2i> findPathJPS(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal);
+	bool findPathJPS(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, int minClearance = 1);
+
+	// Runs Dijkstra from `source` over the tiles inside `bounds` (which must lie inside the map),
+	//  with the same movement rules and costs as `findPathAStar()`.
+	// `outDistances` receives one entry per tile of `bounds`, indexed by `(y - top) * width + (x - left)`,
+	//  set to UNREACHABLE for tiles that cannot be reached without leaving the bounds.
+	void computeDistanceField(const CollisionGrid& grid, const sf::IntRect& bounds, sf::Vector2i source, std::vector<float>& outDistances);
+
+	// Returns true if a mover with its centre on the straight line between the centres of `from` and
+	//  `to` only passes through tiles with at least `minClearance` (both ends included). Where the
+	//  line runs exactly through a corner, both tiles beside it must pass too, like a diagonal step.
+	bool hasClearLine(const CollisionGrid& grid, sf::Vector2i from, sf::Vector2i to, int minClearance);
+	// Removes the waypoints of a tile-by-tile path (start excluded, as the searches return it) that
+	//  can be skipped by moving in a straight line, checked with `hasClearLine()`. Each kept waypoint
+	//  is the last one in a row visible from the one before it, so the path keeps its shape around
+	//  corners but crosses open areas in a single step. The goal is always kept.
+	// `minClearance` should allow for the mover being anywhere within a tile while moving between
+	//  waypoints, see `TileMap::getRequiredClearance()`.
+	void smoothPath(const CollisionGrid& grid, sf::Vector2i start, std::vector<sf::Vector2i>& path, int minClearance);
+
+	// Dispatches to the search selected by `algorithm`. `landmarks` is only used by AStarLandmarks.
+	bool findPath(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, std::vector<sf::Vector2i>& outPath, Algorithm algorithm = Algorithm::AStar, int minClearance = 1,
+		const LandmarkTable* landmarks = nullptr);
 }
\ No newline at end of file
@@ -0,0 +1,130 @@
+// ================================================================================================
+// File: PatrolRoute.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <algorithm>
+#include "PatrolRoute.hpp"
+#include "Navigation.hpp"
+
+using Pathfinding::PatrolRoute;
+
+PatrolRoute::PatrolRoute() :
+	algorithm(Algorithm::AStar),
+	minClearance(1),
+	smoothingClearance(0),
+	isBuilt(false),
+	syncedRevision(0)
+{
+}
+
+bool PatrolRoute::update(const TileMap& tileMap, Navigation& navigation, const std::vector<sf::Vector2i>& patrolPositions,
+	Algorithm algorithm, int minClearance, int smoothingClearance)
+{
+	bool isSameRoute = isBuilt && waypoints == patrolPositions && this->algorithm == algorithm &&
+		this->minClearance == minClearance && this->smoothingClearance == smoothingClearance;
+	bool isMapChanged = tileMap.getRevision() != syncedRevision;
+
+	changedTiles.clear();
+	if (!isSameRoute || (isMapChanged && !tileMap.getChangesSince(syncedRevision, changedTiles)))
+	{
+		cancelRequests();
+		waypoints = patrolPositions;
+		this->algorithm = algorithm;
+		this->minClearance = minClearance;
+		this->smoothingClearance = smoothingClearance;
+		syncedRevision = tileMap.getRevision();
+		isBuilt = true;
+
+		legs.assign(waypoints.size() > 1 ? waypoints.size() : 0, Leg());
+		for (std::size_t from = 0; from < legs.size(); ++from)
+			requestLeg(navigation, from);
+		return true;
+	}
+	syncedRevision = tileMap.getRevision();
+
+	bool hasChanged = false;
+	for (std::size_t from = 0; from < legs.size(); ++from)
+	{
+		Leg& leg = legs[from];
+
+		// A search still queued ran on the old map, it is requested again once it comes in.
+		// A leg without a path may have been opened by any change, not just one near it.
+		bool isAffected = isMapChanged && !leg.pending && (!leg.isFound || std::any_of(changedTiles.begin(), changedTiles.end(),
+			[this, &leg](sf::Vector2i tile) { return isInCorridor(leg, tile); }));
+
+		if (isAffected)
+		{
+			requestLeg(navigation, from);
+			hasChanged = true;
+		}
+		if (leg.pending && leg.pending->isDone)
+			collectLeg(navigation, from);
+	}
+	return hasChanged;
+}
+
+const std::vector<sf::Vector2i>* PatrolRoute::getLeg(std::size_t from) const
+{
+	if (from >= legs.size() || !legs[from].isFound)
+		return nullptr;
+	return &legs[from].path;
+}
+
+void PatrolRoute::requestLeg(Navigation& navigation, std::size_t from)
+{
+	Leg& leg = legs[from];
+	leg.path.clear();
+	leg.corridor.clear();
+	leg.isFound = false;
+
+	if (leg.pending)
+		leg.pending->isCancelled = true;
+	leg.pending = navigation.requestPath(waypoints[from], waypoints[(from + 1) % waypoints.size()], algorithm, minClearance, smoothingClearance);
+}
+
+void PatrolRoute::collectLeg(Navigation& navigation, std::size_t from)
+{
+	Leg& leg = legs[from];
+	std::shared_ptr<PathRequest> request = std::move(leg.pending);
+
+	if (!navigation.isCurrent(*request))
+	{
+		requestLeg(navigation, from);
+		return;
+	}
+	leg.isFound = request->isFound;
+	if (!leg.isFound)
+		return;
+	leg.path = std::move(request->path); // Already smoothed by the worker
+
+	// Whether a tile can be passed depends on the tiles up to the clearance away from it, and a
+	//  smoothed segment may cross any tile of its bounding box, so that box grown by the larger
+	//  clearance holds every tile that could block the segment
+	const int margin = std::max(minClearance, smoothingClearance);
+	sf::Vector2i previous = waypoints[from];
+	for (sf::Vector2i tile : leg.path)
+	{
+		sf::Vector2i min(std::min(previous.x, tile.x) - margin, std::min(previous.y, tile.y) - margin);
+		sf::Vector2i max(std::max(previous.x, tile.x) + margin, std::max(previous.y, tile.y) + margin);
+		leg.corridor.emplace_back(min, max - min + sf::Vector2i(1, 1));
+		previous = tile;
+	}
+}
+
+void PatrolRoute::cancelRequests()
+{
+	for (Leg& leg : legs)
+		if (leg.pending)
+			leg.pending->isCancelled = true;
+}
+
+bool PatrolRoute::isInCorridor(const Leg& leg, sf::Vector2i tile) const
+{
+	return std::any_of(leg.corridor.begin(), leg.corridor.end(),
+		[tile](const sf::IntRect& segment) { return segment.contains(tile); });
+}
@@ -0,0 +1,73 @@
+// ================================================================================================
+// File: PatrolRoute.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the PatrolRoute class, which keeps the searched paths between an enemy's
+//              consecutive patrol positions so patrolling does not have to search again.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "TileMap.hpp"
+#include "Pathfinding.hpp"
+
+class Navigation;
+
+namespace Pathfinding
+{
+	// Paths between consecutive patrol positions (legs), the last one leading back to the first.
+	// Patrol positions rarely change after a map is loaded, so each leg is searched once and then
+	//  reused every time the enemy walks it, until a tile near it changes. The searches are queued
+	//  with `Navigation::requestPath()`, so they run on the workers within the node budget.
+	class PatrolRoute
+	{
+	public:
+		PatrolRoute();
+
+		// Brings the legs up to date. Requests every leg again if the patrol positions or any of the
+		//  search settings changed, otherwise only the legs that pass near a tile changed since the
+		//  last call (per the map's change log) and the legs that had no path. Takes in the results
+		//  of earlier requests that have finished, and requests again those that ran on an older map.
+		// `navigation` must have been updated with the map already. Returns true if any leg's path
+		//  was dropped to be searched again (not when a requested leg comes in).
+		bool update(const TileMap& tileMap, Navigation& navigation, const std::vector<sf::Vector2i>& patrolPositions,
+			Algorithm algorithm, int minClearance, int smoothingClearance);
+
+		// Path from patrol position `from` to the next one, without `from` itself.
+		// Null if there is no path, its search has not finished yet, or the route has fewer than two positions.
+		const std::vector<sf::Vector2i>* getLeg(std::size_t from) const;
+
+	private:
+		struct Leg
+		{
+			std::vector<sf::Vector2i> path;
+			std::vector<sf::IntRect> corridor; // Per segment, the tiles a change in would affect it
+			bool isFound = false;
+			std::shared_ptr<PathRequest> pending; // Null unless its search is queued
+		};
+		// Drops the leg's path and queues its search
+		void requestLeg(Navigation& navigation, std::size_t from);
+		// Takes the leg's path from its finished request, or requests it again if the search ran on an older map
+		void collectLeg(Navigation& navigation, std::size_t from);
+		void cancelRequests();
+		bool isInCorridor(const Leg& leg, sf::Vector2i tile) const;
+
+		std::vector<sf::Vector2i> waypoints; // Patrol positions the legs were searched for
+		std::vector<Leg> legs;
+		Algorithm algorithm;
+		int minClearance;
+		int smoothingClearance;
+
+		bool isBuilt;
+		std::uint64_t syncedRevision;
+		std::vector<sf::Vector2i> changedTiles; // Scratch buffer for `update()`
+	};
+}
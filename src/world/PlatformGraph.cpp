@@ -0,0 +1,340 @@
+// ================================================================================================
+// File: PlatformGraph.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cmath>
+#include <algorithm>
+#include "PlatformGraph.hpp"
+#include "Pathfinding.hpp"
+
+using Pathfinding::PlatformGraph;
+
+namespace
+{
+	struct OpenEntry
+	{
+		float estimatedTotalCost;
+		float costFromStart;
+		int index;
+	};
+
+	struct CompareOpenEntries
+	{
+		bool operator()(const OpenEntry& a, const OpenEntry& b) const
+		{
+			return a.estimatedTotalCost > b.estimatedTotalCost;
+		}
+	};
+
+	// Per-thread scratch state for `PlatformGraph::findPath()`, stamped with a
+	//  generation like the A* buffers so it never has to be cleared.
+	struct PlatformSearchBuffers
+	{
+		std::vector<float> costFromStart;
+		std::vector<int> parent;
+		std::vector<PlatformGraph::LinkType> parentLink;
+		std::vector<std::uint32_t> visitedGeneration;
+		std::vector<OpenEntry> openSet;
+		std::uint32_t generation = 0;
+
+		void begin(std::size_t tileCount)
+		{
+			if (visitedGeneration.size() < tileCount)
+			{
+				costFromStart.resize(tileCount);
+				parent.resize(tileCount);
+				parentLink.resize(tileCount);
+				visitedGeneration.resize(tileCount, 0);
+			}
+			openSet.clear();
+
+			if (++generation == 0)
+			{
+				std::fill(visitedGeneration.begin(), visitedGeneration.end(), 0);
+				generation = 1;
+			}
+		}
+		inline bool isVisited(int index) const { return visitedGeneration[index] == generation; }
+	};
+
+	thread_local PlatformSearchBuffers platformBuffers;
+
+	const std::vector<PlatformGraph::Link> NO_LINKS;
+}
+
+PlatformGraph::PlatformGraph(const JumpProfile& profile) :
+	profile(profile),
+	width(0),
+	height(0),
+	isBuilt(false),
+	syncedRevision(0)
+{
+}
+
+void PlatformGraph::update(const TileMap& tileMap)
+{
+	const CollisionGrid& grid = tileMap.getCollisionGrid();
+
+	if (isBuilt && tileMap.getRevision() == syncedRevision)
+		return;
+
+	changedTiles.clear();
+	if (!isBuilt || !tileMap.getChangesSince(syncedRevision, changedTiles))
+	{
+		rebuildAll(grid);
+		syncedRevision = tileMap.getRevision();
+		isBuilt = true;
+		return;
+	}
+	syncedRevision = tileMap.getRevision();
+
+	// A changed tile only changes which tiles of its own column are nodes, but walks, drops and
+	//  jumps from up to `reach` columns away can lead into or pass through it
+	const int reach = std::max(profile.maxJumpDistance, 1);
+	std::vector<std::uint8_t> isColumnDirty(width, 0);
+	for (const sf::Vector2i& tile : changedTiles)
+	{
+		for (int x = std::max(tile.x - reach, 0); x <= std::min(tile.x + reach, width - 1); ++x)
+			isColumnDirty[x] = 1;
+	}
+
+	for (int x = 0; x < width; ++x)
+	{
+		if (!isColumnDirty[x])
+			continue;
+
+		int lastColumn = x;
+		while (lastColumn + 1 < width && isColumnDirty[lastColumn + 1])
+			++lastColumn;
+
+		rebuildColumns(grid, x, lastColumn);
+		x = lastColumn;
+	}
+}
+
+bool PlatformGraph::findPath(sf::Vector2i start, sf::Vector2i goal, std::vector<Step>& outPath) const
+{
+	outPath.clear();
+
+	sf::Vector2i startNode, goalNode;
+	if (!findSurfaceNode(start, startNode) || !findSurfaceNode(goal, goalNode))
+		return false;
+
+	const int startIndex = startNode.y * width + startNode.x;
+	const int goalIndex = goalNode.y * width + goalNode.x;
+	CompareOpenEntries compare;
+
+	PlatformSearchBuffers& buffers = platformBuffers;
+	buffers.begin(tileStates.size());
+	buffers.visitedGeneration[startIndex] = buffers.generation;
+	buffers.costFromStart[startIndex] = 0.f;
+	buffers.parent[startIndex] = -1;
+	buffers.openSet.push_back({ euclideanHeuristic(startNode, goalNode), 0.f, startIndex });
+
+	while (!buffers.openSet.empty())
+	{
+		std::pop_heap(buffers.openSet.begin(), buffers.openSet.end(), compare);
+		OpenEntry current = buffers.openSet.back();
+		buffers.openSet.pop_back();
+
+		if (current.costFromStart > buffers.costFromStart[current.index])
+			continue; // Stale entry
+
+		if (current.index == goalIndex)
+		{
+			for (int index = goalIndex; buffers.parent[index] != -1; index = buffers.parent[index])
+				outPath.push_back({ sf::Vector2i(index % width, index / width), buffers.parentLink[index] });
+			std::reverse(outPath.begin(), outPath.end());
+			return true;
+		}
+
+		for (const Link& link : links[current.index])
+		{
+			float tentativeG = current.costFromStart + link.cost;
+			if (buffers.isVisited(link.target) && tentativeG >= buffers.costFromStart[link.target])
+				continue;
+
+			buffers.visitedGeneration[link.target] = buffers.generation;
+			buffers.costFromStart[link.target] = tentativeG;
+			buffers.parent[link.target] = current.index;
+			buffers.parentLink[link.target] = link.type;
+
+			sf::Vector2i target(link.target % width, link.target / width);
+			buffers.openSet.push_back({ tentativeG + euclideanHeuristic(target, goalNode), tentativeG, link.target });
+			std::push_heap(buffers.openSet.begin(), buffers.openSet.end(), compare);
+		}
+	}
+	return false; // No path found
+}
+
+bool PlatformGraph::findSurfaceNode(sf::Vector2i tile, sf::Vector2i& outNode) const
+{
+	if (tile.x < 0 || tile.x >= width || tile.y >= height)
+		return false;
+
+	for (int y = std::max(tile.y, 0); y < height; ++y)
+	{
+		std::uint8_t state = tileStates[y * width + tile.x];
+		if (state == Node)
+		{
+			outNode = { tile.x, y };
+			return true;
+		}
+		if (state == Blocked)
+			return false; // Landed somewhere too cramped to stand, or started inside a wall
+	}
+	return false;
+}
+
+bool PlatformGraph::isNode(sf::Vector2i tile) const
+{
+	return tile.x >= 0 && tile.x < width && tile.y >= 0 && tile.y < height && tileStates[tile.y * width + tile.x] == Node;
+}
+
+const std::vector<PlatformGraph::Link>& PlatformGraph::getLinks(sf::Vector2i tile) const
+{
+	if (!isNode(tile))
+		return NO_LINKS;
+	return links[tile.y * width + tile.x];
+}
+
+std::size_t PlatformGraph::getNodeCount() const
+{
+	return static_cast<std::size_t>(std::count(tileStates.begin(), tileStates.end(), static_cast<std::uint8_t>(Node)));
+}
+
+void PlatformGraph::rebuildAll(const CollisionGrid& grid)
+{
+	width = grid.getWidth();
+	height = grid.getHeight();
+	tileStates.assign(static_cast<std::size_t>(width) * height, Open);
+	links.assign(tileStates.size(), {});
+
+	if (width > 0)
+		rebuildColumns(grid, 0, width - 1);
+}
+
+void PlatformGraph::rebuildColumns(const CollisionGrid& grid, int firstColumn, int lastColumn)
+{
+	// Every node has to be known before any links are made, since links point across columns
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = firstColumn; x <= lastColumn; ++x)
+		{
+			TileState state = grid.isSolid(x, y) ? Blocked : canStand(grid, x, y) ? Node : Open;
+			tileStates[y * width + x] = state;
+		}
+	}
+
+	for (int y = 0; y < height; ++y)
+	{
+		for (int x = firstColumn; x <= lastColumn; ++x)
+			rebuildLinks(grid, x, y);
+	}
+}
+
+void PlatformGraph::rebuildLinks(const CollisionGrid& grid, int x, int y)
+{
+	std::vector<Link>& nodeLinks = links[y * width + x];
+	nodeLinks.clear();
+
+	if (tileStates[y * width + x] != Node)
+		return;
+
+	for (int direction : { -1, 1 })
+	{
+		int sideX = x + direction;
+		if (sideX < 0 || sideX >= width)
+			continue;
+
+		if (tileStates[y * width + sideX] == Node)
+		{
+			nodeLinks.push_back({ y * width + sideX, 1.f, LinkType::Walk });
+		}
+		else if (canFit(grid, sideX, y))
+		{
+			// Walk off the ledge and fall until something is in the way
+			for (int landingY = y + 1; landingY < height && canFit(grid, sideX, landingY); ++landingY)
+			{
+				if (tileStates[landingY * width + sideX] == Node)
+				{
+					nodeLinks.push_back({ landingY * width + sideX, 1.f + static_cast<float>(landingY - y), LinkType::Drop });
+					break;
+				}
+			}
+		}
+	}
+
+	if (profile.maxJumpHeight <= 0)
+		return;
+
+	// The corridor rises one tile above the higher end, so jumping up by `dy` takes `1 - dy` tiles of height
+	for (int dy = 1 - profile.maxJumpHeight; dy <= profile.maxJumpHeight; ++dy)
+	{
+		for (int dx = -profile.maxJumpDistance; dx <= profile.maxJumpDistance; ++dx)
+		{
+			if (dx == 0 || (std::abs(dx) == 1 && dy == 0))
+				continue; // Straight up lands back on the same tile, one tile sideways is a walk
+
+			int targetX = x + dx;
+			int targetY = y + dy;
+			if (targetX < 0 || targetX >= width || targetY < 0 || targetY >= height)
+				continue;
+			if (tileStates[targetY * width + targetX] != Node || !isJumpClear(grid, x, y, targetX, targetY))
+				continue;
+
+			float length = std::hypotf(static_cast<float>(dx), static_cast<float>(dy));
+			nodeLinks.push_back({ targetY * width + targetX, length + JUMP_COST, LinkType::Jump });
+		}
+	}
+}
+
+bool PlatformGraph::isFree(const CollisionGrid& grid, int x, int y) const
+{
+	// Above the top of the map counts as open sky
+	return x >= 0 && x < width && y < height && (y < 0 || !grid.isSolid(x, y));
+}
+
+bool PlatformGraph::canFit(const CollisionGrid& grid, int x, int y) const
+{
+	for (int i = 0; i < profile.height; ++i)
+	{
+		if (!isFree(grid, x, y - i))
+			return false;
+	}
+	return true;
+}
+
+bool PlatformGraph::canStand(const CollisionGrid& grid, int x, int y) const
+{
+	return y >= 0 && y + 1 < height && grid.isSolid(x, y + 1) && canFit(grid, x, y);
+}
+
+bool PlatformGraph::isJumpClear(const CollisionGrid& grid, int x, int y, int targetX, int targetY) const
+{
+	// Up from the start, across one tile above the higher end, then down onto the target
+	const int apexY = std::min(y, targetY) - 1;
+	const int step = targetX > x ? 1 : -1;
+
+	for (int rowY = y - 1; rowY >= apexY; --rowY)
+	{
+		if (!canFit(grid, x, rowY))
+			return false;
+	}
+	for (int columnX = x + step; columnX != targetX + step; columnX += step)
+	{
+		if (!canFit(grid, columnX, apexY))
+			return false;
+	}
+	for (int rowY = apexY + 1; rowY < targetY; ++rowY)
+	{
+		if (!canFit(grid, targetX, rowY))
+			return false;
+	}
+	return true;
+}
@@ -0,0 +1,115 @@
+// ================================================================================================
+// File: PlatformGraph.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the PlatformGraph class, a navigation graph of the surfaces a walking enemy
+//              can stand on, linked by walks, jumps and drops.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+#include "TileMap.hpp"
+
+namespace Pathfinding
+{
+	// What a walking enemy can do, in tiles
+	struct JumpProfile
+	{
+		int height = 1;          // Tiles the body takes up, counting up from the tile it stands in
+		int maxJumpHeight = 0;   // How many tiles a jump can rise
+		int maxJumpDistance = 0; // How many tiles a jump can cover sideways
+
+		inline bool operator==(const JumpProfile& other) const
+		{
+			return height == other.height && maxJumpHeight == other.maxJumpHeight && maxJumpDistance == other.maxJumpDistance;
+		}
+	};
+
+	// Nodes are the tiles a walker with a given JumpProfile can stand in (free, with solid ground
+	//  below and room for its body above). Each node links to the nodes it can reach by walking
+	//  one tile sideways, by jumping, or by walking off a ledge and falling.
+	// Jump links are checked against a simple up-across-down corridor instead of a simulated arc,
+	//  which is slightly conservative but lets the whole graph be precomputed, so searches never
+	//  have to evaluate jump feasibility while they expand.
+	class PlatformGraph
+	{
+	public:
+		enum class LinkType : std::uint8_t
+		{
+			Walk,
+			Jump,
+			Drop
+		};
+
+		struct Link
+		{
+			int target; // Tile index (y * width + x) of the node it leads to
+			float cost;
+			LinkType type;
+		};
+
+		// One step of a path: the tile reached and how to get there from the previous one
+		struct Step
+		{
+			sf::Vector2i tile;
+			LinkType type;
+		};
+
+		explicit PlatformGraph(const JumpProfile& profile);
+
+		// Brings the graph up to date with the map. After the first build only the columns
+		//  near tiles changed since the last call (per the map's change log) are relinked.
+		void update(const TileMap& tileMap);
+
+		// Finds the cheapest sequence of links from `start` to `goal`, which may be in mid-air:
+		//  both are first moved straight down onto the surface below them.
+		// `update()` must have been called since the map was last changed.
+		// Returns false (with `outPath` left empty) if no path is found.
+		bool findPath(sf::Vector2i start, sf::Vector2i goal, std::vector<Step>& outPath) const;
+
+		// Moves `tile` straight down onto the first node below it (or leaves it if it is one).
+		// Returns false if it would fall out of the map.
+		bool findSurfaceNode(sf::Vector2i tile, sf::Vector2i& outNode) const;
+
+		bool isNode(sf::Vector2i tile) const;
+		const std::vector<Link>& getLinks(sf::Vector2i tile) const;
+		const JumpProfile& getProfile() const { return profile; }
+		std::size_t getNodeCount() const;
+
+		// Added to the straight-line length of every jump, so walking is preferred when it is about as short
+		static constexpr float JUMP_COST = 1.f;
+
+	private:
+		void rebuildAll(const CollisionGrid& grid);
+		void rebuildColumns(const CollisionGrid& grid, int firstColumn, int lastColumn);
+		void rebuildLinks(const CollisionGrid& grid, int x, int y);
+
+		bool isFree(const CollisionGrid& grid, int x, int y) const;
+		bool canFit(const CollisionGrid& grid, int x, int y) const;
+		bool canStand(const CollisionGrid& grid, int x, int y) const;
+		bool isJumpClear(const CollisionGrid& grid, int x, int y, int targetX, int targetY) const;
+
+		enum TileState : std::uint8_t
+		{
+			Open,
+			Node,
+			Blocked
+		};
+
+		JumpProfile profile;
+		int width;
+		int height;
+		std::vector<std::uint8_t> tileStates; // Per tile, a TileState
+		std::vector<std::vector<Link>> links; // Per tile, empty unless it is a node
+
+		bool isBuilt;
+		std::uint64_t syncedRevision;
+		std::vector<sf::Vector2i> changedTiles; // Scratch buffer for `update()`
+	};
+}
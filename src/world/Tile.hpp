@@ -10,9 +10,12 @@
 
 #pragma once
 
+#include <cstdint>
+
+// A tile is stored as a single byte, so a TileMap row is a tightly packed array of tile ids.
 struct Tile
 {
-	enum class Type
+	enum class Type : std::uint8_t
 	{
 		EMPTY,
 		Background,
@@ -21,4 +24,8 @@ struct Tile
 		Door
 	};
 	Type type;
-};
\ No newline at end of file
+
+	// Translucent tiles are rendered in a separate pass after all opaque tiles.
+	static constexpr bool isTranslucent(Type type) { return type == Type::Water; }
+};
+static_assert(sizeof(Tile) == 1, "Tile is expected to be packed into a single byte");
\ No newline at end of file
@@ -10,12 +10,155 @@
 #include <iostream>
 #include <fstream>
 #include <filesystem>
+#include <algorithm>
+#include <cmath>
+#include <limits>
 #include "TileMap.hpp"
 
+namespace
+{
+	// Blocking tests for the raycast kernel. Solid tiles alone can be read from the collision bits,
+	//  any other set of types needs the tile itself.
+	struct IsSolidTile
+	{
+		const TileMap& tileMap;
+		inline bool operator()(int x, int y) const { return tileMap.isSolid(x, y); }
+	};
+	struct IsTileInMask
+	{
+		const TileMap& tileMap;
+		std::uint32_t tileMask;
+		inline bool operator()(int x, int y) const
+		{
+			return tileMap.isWithinBounds(x, y) && (tileMask & TileMap::getTileMask(tileMap.getTile(x, y).type)) != 0;
+		}
+	};
+
+	// Boundary crossings closer together than this (in pixels along the ray) count as a corner.
+	// Well above the rounding the crossing distances pick up over a long ray.
+	constexpr float CORNER_TOLERANCE = 0.01f;
+
+	// Amanatides-Woo traversal of the tiles along the ray, in pixels, stopping at the first one
+	//  `isBlocking` accepts. The ray is clipped to the map first, since nothing outside can be hit.
+	template <typename IsBlocking>
+	bool castRay(const TileMap& tileMap, const TileMap::Ray& ray, const IsBlocking& isBlocking, TileMap::RaycastHit& outHit)
+	{
+		constexpr float TILE_SIZE = TileMap::TILE_SIZE;
+		const float infinity = std::numeric_limits<float>::infinity();
+		outHit = TileMap::RaycastHit();
+
+		float length = std::hypotf(ray.direction.x, ray.direction.y);
+		if (length == 0.f || ray.maxDistance < 0.f)
+			return false;
+		const sf::Vector2f direction = ray.direction / length;
+		const sf::Vector2f mapSize(tileMap.getWidth() * TILE_SIZE, tileMap.getHeight() * TILE_SIZE);
+
+		// Clip to the map one axis at a time, remembering which face the ray enters through
+		float enter = 0.f;
+		float exit = ray.maxDistance;
+		sf::Vector2f enterNormal(0.f, 0.f);
+		for (int axis = 0; axis < 2; ++axis)
+		{
+			float origin = axis == 0 ? ray.origin.x : ray.origin.y;
+			float step = axis == 0 ? direction.x : direction.y;
+			float size = axis == 0 ? mapSize.x : mapSize.y;
+
+			if (step == 0.f)
+			{
+				if (origin < 0.f || origin >= size)
+					return false;
+				continue;
+			}
+			float entry = ((step > 0.f ? 0.f : size) - origin) / step;
+			float leave = ((step > 0.f ? size : 0.f) - origin) / step;
+			if (entry > enter)
+			{
+				enter = entry;
+				enterNormal = axis == 0 ? sf::Vector2f(step > 0.f ? -1.f : 1.f, 0.f) : sf::Vector2f(0.f, step > 0.f ? -1.f : 1.f);
+			}
+			exit = std::min(exit, leave);
+		}
+		if (enter > exit)
+			return false;
+
+		const sf::Vector2f start = ray.origin + direction * enter;
+		sf::Vector2i tile(
+			std::clamp(static_cast<int>(std::floor(start.x / TILE_SIZE)), 0, tileMap.getWidth() - 1),
+			std::clamp(static_cast<int>(std::floor(start.y / TILE_SIZE)), 0, tileMap.getHeight() - 1));
+
+		auto reportHit = [&](float distance, sf::Vector2f normal)
+			{
+				outHit.isHit = true;
+				outHit.tile = tile;
+				outHit.point = ray.origin + direction * distance;
+				outHit.normal = normal;
+				outHit.distance = distance;
+				return true;
+			};
+
+		if (isBlocking(tile.x, tile.y))
+			return reportHit(enter, enterNormal);
+
+		// Distance along the ray to the next column and row boundary, and between two of them
+		const int stepX = direction.x > 0.f ? 1 : -1;
+		const int stepY = direction.y > 0.f ? 1 : -1;
+		const float deltaX = direction.x != 0.f ? TILE_SIZE / std::fabs(direction.x) : infinity;
+		const float deltaY = direction.y != 0.f ? TILE_SIZE / std::fabs(direction.y) : infinity;
+		float nextX = direction.x != 0.f ? ((tile.x + (stepX > 0 ? 1 : 0)) * TILE_SIZE - ray.origin.x) / direction.x : infinity;
+		float nextY = direction.y != 0.f ? ((tile.y + (stepY > 0 ? 1 : 0)) * TILE_SIZE - ray.origin.y) / direction.y : infinity;
+
+		while (true)
+		{
+			bool isStepX = nextX <= nextY;
+			float distance = isStepX ? nextX : nextY;
+			if (distance > exit)
+				return false;
+
+			if (std::fabs(nextX - nextY) <= CORNER_TOLERANCE)
+			{
+				// Exactly through a corner the ray only touches the two tiles beside it, so it passes
+				//  between them unless both block. Stepping one axis first would make the result
+				//  depend on which way the ray is cast.
+				if (isBlocking(tile.x + stepX, tile.y) && isBlocking(tile.x, tile.y + stepY))
+				{
+					tile.x += stepX;
+					return reportHit(distance, sf::Vector2f(-static_cast<float>(stepX), 0.f));
+				}
+				tile.x += stepX;
+				tile.y += stepY;
+				nextX += deltaX;
+				nextY += deltaY;
+			}
+			else if (isStepX)
+			{
+				tile.x += stepX;
+				nextX += deltaX;
+			}
+			else
+			{
+				tile.y += stepY;
+				nextY += deltaY;
+			}
+			if (tile.x < 0 || tile.y < 0 || tile.x >= tileMap.getWidth() || tile.y >= tileMap.getHeight())
+				return false; // Left the map, rounding kept it from matching `exit` exactly
+
+			if (isBlocking(tile.x, tile.y))
+				return reportHit(distance, isStepX ? sf::Vector2f(-static_cast<float>(stepX), 0.f) : sf::Vector2f(0.f, -static_cast<float>(stepY)));
+		}
+	}
+}
+
 TileMap::TileMap(int width, int height) :
 	gridLines(sf::PrimitiveType::Lines),
 	gridColor(sf::Color(255, 255, 255, 50)),
-	isGridShown(false)
+	isGridShown(false),
+	width(0),
+	height(0),
+	opaqueBatch(sf::PrimitiveType::Triangles),
+	translucentBatch(sf::PrimitiveType::Triangles),
+	revision(0),
+	changeLogStart(0),
+	editDepth(0)
 {
 	resize(width, height);
 	rebuildGridLines();
@@ -144,32 +287,103 @@ void TileMap::renderGrid(sf::RenderWindow& window)
 
 void TileMap::rebuildVisuals()
 {
-    visuals.clear();
-
-    for (size_t y = 0; y < tiles.size(); ++y) {
-        for (size_t x = 0; x < tiles[y].size(); ++x) {
-            const Tile& tile = tiles[y][x];
-            if (tile.type == Tile::Type::EMPTY) continue;
-
-            sf::RectangleShape rect(sf::Vector2f(TILE_SIZE, TILE_SIZE));
-            rect.setPosition({ static_cast<float>(x * TILE_SIZE), static_cast<float>(y * TILE_SIZE) });
-			rect.setFillColor(getTileColor(tile.type));
-            visuals.push_back(rect);
-        }
-    }
+	for (auto& chunk : chunks)
+		chunk.isDirty = true;
+}
+
+void TileMap::rebuildChunk(int chunkX, int chunkY) const
+{
+	Chunk& chunk = chunks[chunkY * chunkCount.x + chunkX];
+	chunk.vertices.clear();
+
+	int startX = chunkX * CHUNK_SIZE;
+	int startY = chunkY * CHUNK_SIZE;
+	int endX = std::min(startX + CHUNK_SIZE, getSize().x);
+	int endY = std::min(startY + CHUNK_SIZE, getSize().y);
+
+	auto appendTile = [&](int x, int y, sf::Color color)
+	{
+		sf::Vector2f topLeft(x * TILE_SIZE, y * TILE_SIZE);
+		sf::Vector2f topRight(topLeft.x + TILE_SIZE, topLeft.y);
+		sf::Vector2f bottomLeft(topLeft.x, topLeft.y + TILE_SIZE);
+		sf::Vector2f bottomRight(topLeft.x + TILE_SIZE, topLeft.y + TILE_SIZE);
+
+		chunk.vertices.append(sf::Vertex{ topLeft, color });
+		chunk.vertices.append(sf::Vertex{ topRight, color });
+		chunk.vertices.append(sf::Vertex{ bottomLeft, color });
+		chunk.vertices.append(sf::Vertex{ bottomLeft, color });
+		chunk.vertices.append(sf::Vertex{ topRight, color });
+		chunk.vertices.append(sf::Vertex{ bottomRight, color });
+	};
+
+	// Opaque tiles first, then translucent ones
+	for (bool translucent : { false, true })
+	{
+		if (translucent)
+			chunk.translucentStart = chunk.vertices.getVertexCount();
+
+		for (int y = startY; y < endY; ++y)
+		{
+			for (int x = startX; x < endX; ++x)
+			{
+				const Tile& tile = tiles[getIndex(x, y)];
+				if (tile.type == Tile::Type::EMPTY)
+					continue;
+
+				if (Tile::isTranslucent(tile.type) == translucent)
+					appendTile(x, y, getTileColor(tile.type));
+			}
+		}
+	}
+	chunk.isDirty = false;
+}
+
+void TileMap::rebuildBatches(const sf::IntRect& chunkRange) const
+{
+	std::size_t opaqueCount = 0;
+	std::size_t translucentCount = 0;
+
+	for (int chunkY = chunkRange.position.y; chunkY < chunkRange.position.y + chunkRange.size.y; ++chunkY)
+	{
+		for (int chunkX = chunkRange.position.x; chunkX < chunkRange.position.x + chunkRange.size.x; ++chunkX)
+		{
+			const Chunk& chunk = chunks[chunkY * chunkCount.x + chunkX];
+			opaqueCount += chunk.translucentStart;
+			translucentCount += chunk.vertices.getVertexCount() - chunk.translucentStart;
+		}
+	}
+	opaqueBatch.resize(opaqueCount);
+	translucentBatch.resize(translucentCount);
+
+	std::size_t opaqueOffset = 0;
+	std::size_t translucentOffset = 0;
+
+	for (int chunkY = chunkRange.position.y; chunkY < chunkRange.position.y + chunkRange.size.y; ++chunkY)
+	{
+		for (int chunkX = chunkRange.position.x; chunkX < chunkRange.position.x + chunkRange.size.x; ++chunkX)
+		{
+			const Chunk& chunk = chunks[chunkY * chunkCount.x + chunkX];
+			for (std::size_t i = 0; i < chunk.translucentStart; ++i)
+				opaqueBatch[opaqueOffset++] = chunk.vertices[i];
+			for (std::size_t i = chunk.translucentStart; i < chunk.vertices.getVertexCount(); ++i)
+				translucentBatch[translucentOffset++] = chunk.vertices[i];
+		}
+	}
+	batchedChunks = chunkRange;
 }
 
 void TileMap::serialize(json& j) const
 {
-	j["width"] = static_cast<int>(tiles[0].size());
-	j["height"] = static_cast<int>(tiles.size());
+	j["width"] = width;
+	j["height"] = height;
 	j["tiles"] = json::array();
 
-	for (int y = 0; y < tiles.size(); ++y)
+	for (int y = 0; y < height; ++y)
 	{
-		for (int x = 0; x < tiles[y].size(); ++x)
+		RowView row = getRow(y);
+		for (int x = 0; x < width; ++x)
 		{
-			const Tile& tile = tiles[y][x];
+			const Tile& tile = row[x];
 			if (tile.type != Tile::Type::EMPTY)
 			{
 				j["tiles"].push_back({
@@ -193,27 +407,83 @@ void TileMap::deserialize(const json& j)
 		int x = tileData["x"];
 		int y = tileData["y"];
 		Tile::Type type = static_cast<Tile::Type>(tileData["type"]);
-		setTile(x, y, Tile{ type });
+		writeTile(x, y, Tile{ type });
 	}
+	// Once for the whole map rather than around every loaded tile
+	collision.applyChanges();
 }
 
 void TileMap::resize(int width, int height)
 {
-    tiles = std::vector<std::vector<Tile>>(height, std::vector<Tile>(width));
-	rebuildVisuals();
+	this->width = width;
+	this->height = height;
+	tiles.assign(static_cast<std::size_t>(width) * height, Tile{ Tile::Type::EMPTY });
+
+	collision.resize(width, height);
+
+	chunkCount = { (width + CHUNK_SIZE - 1) / CHUNK_SIZE, (height + CHUNK_SIZE - 1) / CHUNK_SIZE };
+	chunks = std::vector<Chunk>(chunkCount.x * chunkCount.y);
+
+	++revision;
+	changeLogStart = revision;
+	changeLog.clear();
+
 	rebuildGridLines();
 }
 
-void TileMap::setTile(int x, int y, Tile tile, bool shouldRebuildVisuals)
+void TileMap::setTile(int x, int y, Tile tile)
 {
-	if (x < 0 || x >= static_cast<int>(tiles[0].size()) || y < 0 || y >= static_cast<int>(tiles.size()))
+	writeTile(x, y, tile);
+	if (editDepth == 0)
+		collision.applyChanges();
+}
+
+void TileMap::beginEdit()
+{
+	++editDepth;
+}
+
+void TileMap::endEdit()
+{
+	if (editDepth > 0 && --editDepth == 0)
+		collision.applyChanges();
+}
+
+void TileMap::writeTile(int x, int y, Tile tile)
+{
+	if (!isWithinBounds(x, y))
 	{
 		std::cerr << "Error: Tile coordinates out of bounds!" << std::endl;
 		return;
 	}
-    tiles[y][x] = tile;
-	if (shouldRebuildVisuals)
-		rebuildVisuals();
+	Tile& current = tiles[getIndex(x, y)];
+	if (current.type != tile.type)
+	{
+		changeLog.push_back({ ++revision, { x, y } });
+		if (changeLog.size() > MAX_CHANGE_LOG_SIZE)
+		{
+			// Drop the older half at once so trimming stays cheap on average
+			std::size_t dropped = changeLog.size() / 2;
+			changeLogStart = changeLog[dropped - 1].revision;
+			changeLog.erase(changeLog.begin(), changeLog.begin() + dropped);
+		}
+	}
+	current = tile;
+
+	collision.setSolid(x, y, tile.type == Tile::Type::Solid);
+	chunks[getChunkIndex(x, y)].isDirty = true;
+}
+
+bool TileMap::getChangesSince(std::uint64_t sinceRevision, std::vector<sf::Vector2i>& outChanges) const
+{
+	if (sinceRevision < changeLogStart)
+		return false;
+
+	// Revisions in the log are consecutive, so the first wanted entry can be indexed directly
+	std::size_t first = static_cast<std::size_t>(sinceRevision - changeLogStart);
+	for (std::size_t i = first; i < changeLog.size(); ++i)
+		outChanges.push_back(changeLog[i].position);
+	return true;
 }
 
 sf::Color TileMap::getTileColor(Tile::Type type) const
@@ -233,34 +503,46 @@ sf::Color TileMap::getTileColor(Tile::Type type) const
 	}
 }
 
-bool TileMap::isWithinBounds(int x, int y) const
+int TileMap::getRequiredClearance(sf::Vector2f size)
+{
+	// From anywhere in a tile, a box reaches at most ceil(half extent) tiles past it on each side
+	float halfExtent = std::max(size.x, size.y) / 2.f;
+	int reach = static_cast<int>(std::ceil(halfExtent / TILE_SIZE));
+	return std::min(reach + 1, CollisionGrid::MAX_CLEARANCE + 1);
+}
+
+int TileMap::getRequiredClearanceAtCenter(sf::Vector2f size)
 {
-	return x >= 0 && x < static_cast<int>(tiles[0].size()) && y >= 0 && y < static_cast<int>(tiles.size());
+	// From the centre, only the part of the box sticking out of the tile counts
+	float halfExtent = std::max(size.x, size.y) / 2.f;
+	int reach = static_cast<int>(std::ceil(std::max(halfExtent - TILE_SIZE / 2.f, 0.f) / TILE_SIZE));
+	return std::min(reach + 1, CollisionGrid::MAX_CLEARANCE + 1);
+}
+
+sf::IntRect TileMap::getOverlappedTiles(const sf::FloatRect& rect, int padding)
+{
+	int left = static_cast<int>(std::floor(rect.position.x / TILE_SIZE)) - padding;
+	int top = static_cast<int>(std::floor(rect.position.y / TILE_SIZE)) - padding;
+	int right = static_cast<int>(std::floor((rect.position.x + rect.size.x) / TILE_SIZE)) + padding;
+	int bottom = static_cast<int>(std::floor((rect.position.y + rect.size.y) / TILE_SIZE)) + padding;
+
+	return sf::IntRect({ left, top }, { right - left + 1, bottom - top + 1 });
 }
 
 bool TileMap::collidesWith(const sf::FloatRect& rect) const
 {
-	int left = static_cast<int>(std::floor(rect.position.x / TILE_SIZE));
-	int top = static_cast<int>(std::floor(rect.position.y / TILE_SIZE));
-	int right = static_cast<int>(std::floor((rect.position.x + rect.size.x) / TILE_SIZE));
-	int bottom = static_cast<int>(std::floor((rect.position.y + rect.size.y) / TILE_SIZE));
+	sf::IntRect tileRange = getOverlappedTiles(rect);
+	int left = tileRange.position.x;
+	int top = tileRange.position.y;
+	int right = left + tileRange.size.x - 1;
+	int bottom = top + tileRange.size.y - 1;
 
 	// Quick bounds check
 	if (!isWithinBounds(sf::Vector2i(left, top)) || !isWithinBounds(sf::Vector2i(right, bottom)))
 		return true; // Treat out-of-bounds as solid (blocking)
 
-	for (int y = top; y <= bottom; ++y)
-	{
-		for (int x = left; x <= right; ++x)
-		{
-			sf::Vector2i tilePos(x, y);
-			if (!isWithinBounds(tilePos))
-				return true; // Treat outside as blocking
-
-			if (getTile(tilePos).type == Tile::Type::Solid)
-				return true;
-		}
-	}
+	if (anySolidInRect(tileRange))
+		return true;
 
 	// Diagonal corner check
 	// Check if rect overlaps a corner between two solid tiles (top-left corner of rect for example)
@@ -306,14 +588,13 @@ bool TileMap::collidesWith(const sf::FloatRect& rect) const
 
 		if (isWithinBounds(n1) && isWithinBounds(n2))
 		{
-			if (getTile(n1).type == Tile::Type::Solid &&
-				getTile(n2).type == Tile::Type::Solid)
+			if (isSolid(n1) && isSolid(n2))
 			{
 				// Additionally check the diagonal tile between these two neighbors
 				sf::Vector2i diag(cx + pair.first.x + pair.second.x, cy + pair.first.y + pair.second.y);
 				if (isWithinBounds(diag))
 				{
-					if (getTile(diag).type == Tile::Type::Solid)
+					if (isSolid(diag))
 					{
 						return true; // Solid diagonal corner blocking movement
 					}
@@ -330,16 +611,191 @@ bool TileMap::collidesWith(const sf::FloatRect& rect) const
 	return false; // No collisions found
 }
 
+sf::IntRect TileMap::getVisibleTileRange(const sf::View& view, const sf::Transform& transform) const
+{
+	// The view's transform takes world space to the (-1, -1) to (1, 1) square that ends up on screen,
+	//  so undoing both transforms on that square gives the visible area in the map's own space
+	sf::Transform screenToLocal = (view.getTransform() * transform).getInverse();
+	sf::FloatRect visibleArea = screenToLocal.transformRect(sf::FloatRect({ -1.f, -1.f }, { 2.f, 2.f }));
+	sf::Vector2f topLeft = visibleArea.position;
+	sf::Vector2f bottomRight = visibleArea.position + visibleArea.size;
+
+	int left = std::max(0, static_cast<int>(std::floor(topLeft.x / TILE_SIZE)));
+	int top = std::max(0, static_cast<int>(std::floor(topLeft.y / TILE_SIZE)));
+	int right = std::min(getSize().x - 1, static_cast<int>(std::floor(bottomRight.x / TILE_SIZE)));
+	int bottom = std::min(getSize().y - 1, static_cast<int>(std::floor(bottomRight.y / TILE_SIZE)));
+
+	if (left > right || top > bottom)
+		return sf::IntRect({ 0, 0 }, { 0, 0 }); // View does not overlap the map
+
+	return sf::IntRect({ left, top }, { right - left + 1, bottom - top + 1 });
+}
+
+bool TileMap::raycast(sf::Vector2f origin, sf::Vector2f direction, float maxDistance, RaycastHit& outHit, std::uint32_t tileMask) const
+{
+	Ray ray{ origin, direction, maxDistance };
+	if (tileMask == SOLID_TILE_MASK)
+		return castRay(*this, ray, IsSolidTile{ *this }, outHit);
+	return castRay(*this, ray, IsTileInMask{ *this, tileMask }, outHit);
+}
+
+void TileMap::raycast(const std::vector<Ray>& rays, std::vector<RaycastHit>& outHits, std::uint32_t tileMask) const
+{
+	outHits.resize(rays.size());
+
+	// The blocking test is picked once for the whole batch, so the loop runs a single kernel
+	if (tileMask == SOLID_TILE_MASK)
+	{
+		IsSolidTile isBlocking{ *this };
+		for (std::size_t i = 0; i < rays.size(); ++i)
+			castRay(*this, rays[i], isBlocking, outHits[i]);
+	}
+	else
+	{
+		IsTileInMask isBlocking{ *this, tileMask };
+		for (std::size_t i = 0; i < rays.size(); ++i)
+			castRay(*this, rays[i], isBlocking, outHits[i]);
+	}
+}
+
+bool TileMap::sweepBox(const sf::FloatRect& box, sf::Vector2f direction, float maxDistance, RaycastHit& outHit, std::uint32_t tileMask) const
+{
+	const float infinity = std::numeric_limits<float>::infinity();
+	outHit = RaycastHit();
+
+	auto isBlocking = [this, tileMask](int x, int y)
+		{
+			return isWithinBounds(x, y) && (tileMask & getTileMask(getTile(x, y).type)) != 0;
+		};
+	// Looks for a blocking tile in the given inclusive range, clipped to the map
+	auto findBlocking = [&](int left, int top, int right, int bottom, sf::Vector2i& outTile)
+		{
+			for (int y = std::max(top, 0); y <= std::min(bottom, height - 1); ++y)
+			{
+				for (int x = std::max(left, 0); x <= std::min(right, width - 1); ++x)
+				{
+					if (isBlocking(x, y))
+					{
+						outTile = { x, y };
+						return true;
+					}
+				}
+			}
+			return false;
+		};
+	// First and last tile along one axis that the span [start, start + size) overlaps
+	auto firstTile = [](float start) { return static_cast<int>(std::floor(start / TILE_SIZE)); };
+	auto lastTile = [](float end) { return static_cast<int>(std::ceil(end / TILE_SIZE)) - 1; };
+
+	float length = std::hypotf(direction.x, direction.y);
+	if (length == 0.f || maxDistance < 0.f)
+		return false;
+	direction /= length;
+
+	sf::Vector2i tile;
+	if (findBlocking(firstTile(box.position.x), firstTile(box.position.y),
+		lastTile(box.position.x + box.size.x), lastTile(box.position.y + box.size.y), tile))
+	{
+		outHit = { true, tile, box.position, { 0.f, 0.f }, 0.f };
+		return true;
+	}
+
+	// Like a raycast, but for the leading edges: whenever one crosses into a new column or row,
+	//  the tiles it enters across the box's current extent on the other axis are checked.
+	// The leading column and row are counted rather than recomputed, so when both are crossed at
+	//  once the second check already covers the corner tile the first one entered.
+	const int stepX = direction.x > 0.f ? 1 : -1;
+	const int stepY = direction.y > 0.f ? 1 : -1;
+	int leadX = direction.x > 0.f ? lastTile(box.position.x + box.size.x) : firstTile(box.position.x);
+	int leadY = direction.y > 0.f ? lastTile(box.position.y + box.size.y) : firstTile(box.position.y);
+	const float deltaX = direction.x != 0.f ? TILE_SIZE / std::fabs(direction.x) : infinity;
+	const float deltaY = direction.y != 0.f ? TILE_SIZE / std::fabs(direction.y) : infinity;
+	float nextX = infinity;
+	float nextY = infinity;
+	if (direction.x > 0.f)
+		nextX = ((leadX + 1) * TILE_SIZE - (box.position.x + box.size.x)) / direction.x;
+	else if (direction.x < 0.f)
+		nextX = (leadX * TILE_SIZE - box.position.x) / direction.x;
+	if (direction.y > 0.f)
+		nextY = ((leadY + 1) * TILE_SIZE - (box.position.y + box.size.y)) / direction.y;
+	else if (direction.y < 0.f)
+		nextY = (leadY * TILE_SIZE - box.position.y) / direction.y;
+
+	while (true)
+	{
+		// Once a leading edge has left the map, crossing further lines on that axis cannot hit anything
+		if ((stepX > 0 && leadX >= width) || (stepX < 0 && leadX < 0))
+			nextX = infinity;
+		if ((stepY > 0 && leadY >= height) || (stepY < 0 && leadY < 0))
+			nextY = infinity;
+
+		bool isStepX = nextX <= nextY;
+		float distance = isStepX ? nextX : nextY;
+		if (distance > maxDistance || distance == infinity)
+			return false;
+
+		sf::Vector2f position = box.position + direction * distance;
+		sf::Vector2f normal;
+		bool isBlocked;
+		if (isStepX)
+		{
+			leadX += stepX;
+			nextX += deltaX;
+
+			int top = direction.y < 0.f ? leadY : firstTile(position.y);
+			int bottom = direction.y > 0.f ? leadY : lastTile(position.y + box.size.y);
+			isBlocked = findBlocking(leadX, top, leadX, bottom, tile);
+			normal = { -static_cast<float>(stepX), 0.f };
+		}
+		else
+		{
+			leadY += stepY;
+			nextY += deltaY;
+
+			int left = direction.x < 0.f ? leadX : firstTile(position.x);
+			int right = direction.x > 0.f ? leadX : lastTile(position.x + box.size.x);
+			isBlocked = findBlocking(left, leadY, right, leadY, tile);
+			normal = { 0.f, -static_cast<float>(stepY) };
+		}
+
+		if (isBlocked)
+		{
+			outHit = { true, tile, position, normal, distance };
+			return true;
+		}
+	}
+}
+
 void TileMap::draw(sf::RenderTarget& target, sf::RenderStates states) const
 {
     states.transform *= getTransform();
-	for (const auto& rect : visuals)
-	{
-		if (drawTransparentOnly && rect.getFillColor().a == 255)
-			continue;
-		if (!drawTransparentOnly && rect.getFillColor().a != 255)
-			continue;
 
-		target.draw(rect, states);
+	sf::IntRect visibleTiles = getVisibleTileRange(target.getView(), states.transform);
+	if (visibleTiles.size.x <= 0 || visibleTiles.size.y <= 0)
+		return;
+
+	int firstChunkX = visibleTiles.position.x / CHUNK_SIZE;
+	int firstChunkY = visibleTiles.position.y / CHUNK_SIZE;
+	int lastChunkX = (visibleTiles.position.x + visibleTiles.size.x - 1) / CHUNK_SIZE;
+	int lastChunkY = (visibleTiles.position.y + visibleTiles.size.y - 1) / CHUNK_SIZE;
+	sf::IntRect visibleChunks({ firstChunkX, firstChunkY }, { lastChunkX - firstChunkX + 1, lastChunkY - firstChunkY + 1 });
+
+	bool shouldRebuildBatches = visibleChunks != batchedChunks;
+	for (int chunkY = firstChunkY; chunkY <= lastChunkY; ++chunkY)
+	{
+		for (int chunkX = firstChunkX; chunkX <= lastChunkX; ++chunkX)
+		{
+			if (chunks[chunkY * chunkCount.x + chunkX].isDirty)
+			{
+				rebuildChunk(chunkX, chunkY);
+				shouldRebuildBatches = true;
+			}
+		}
 	}
+	if (shouldRebuildBatches)
+		rebuildBatches(visibleChunks);
+
+	const sf::VertexArray& batch = drawTransparentOnly ? translucentBatch : opaqueBatch;
+	if (batch.getVertexCount() > 0)
+		target.draw(batch, states);
 }
\ No newline at end of file
@@ -10,11 +10,16 @@
 
 #pragma once
 
+#include <cstdint>
+#include <vector>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/Graphics/Drawable.hpp>
 #include <SFML/Graphics/Transformable.hpp>
 #include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include <SFML/Graphics/View.hpp>
 #include "Tile.hpp"
+#include "CollisionGrid.hpp"
 #include "../core/Serializable.hpp"
 
 class TileMap : public sf::Drawable, public sf::Transformable, public Serializable
@@ -35,36 +40,184 @@ public:
 	void deserialize(const json& j) override;
 	std::string getType() const override { return "TileMap"; }
 
+	// Read-only view of a single contiguous row of tiles.
+	struct RowView
+	{
+		const Tile* data;
+		int size;
+
+		inline const Tile& operator[](int x) const { return data[x]; }
+		inline const Tile* begin() const { return data; }
+		inline const Tile* end() const { return data + size; }
+	};
+
 	void resize(int width, int height);
-	inline sf::Vector2i getSize() const { return sf::Vector2i(tiles[0].size(), tiles.size()); }
+	inline sf::Vector2i getSize() const { return sf::Vector2i(width, height); }
+	inline int getWidth() const { return width; }
+	inline int getHeight() const { return height; }
+	// Number of tiles between the start of two consecutive rows in the underlying buffer.
+	inline int getStride() const { return width; }
+	inline RowView getRow(int y) const { return RowView{ &tiles[static_cast<std::size_t>(y) * getStride()], width }; }
 
 	void toggleGrid() { isGridShown = !isGridShown; }
 	void setIsGridShown(bool isShown) { isGridShown = isShown; }
 	void rebuildGridLines();
 	void renderGrid(sf::RenderWindow& window);
 
+	// Marks every chunk as dirty so that its vertices are rebuilt the next time it is drawn.
 	void rebuildVisuals();
-	void setTile(int x, int y, Tile tile, bool shouldRebuildVisuals = true);
-	inline void setTile(sf::Vector2i coords, Tile tile, bool shouldRebuildVisuals = true) { setTile(coords.x, coords.y, tile, shouldRebuildVisuals); }
-	inline const Tile& getTile(int x, int y) const { return tiles[y][x]; }
+	// Changes a single tile. Only the chunk containing the tile is marked dirty, and the collision
+	//  grid is only updated around the tile, so the cost of a change does not depend on the size
+	//  of the map. A change that cuts a large region in two leaves the parts sharing a region
+	//  label until `refineRegions()` has relabelled them (see `CollisionGrid::areRegionsExact()`).
+	void setTile(int x, int y, Tile tile);
+	inline void setTile(sf::Vector2i coords, Tile tile) { setTile(coords.x, coords.y, tile); }
+	// Between `beginEdit()` and `endEdit()`, `setTile()` only writes the tiles, and the clearance
+	//  and regions of the collision grid are brought up to date once by `endEdit()`. Use it to
+	//  change many tiles at once; until then only `isSolid()` sees the new tiles. Calls may nest.
+	void beginEdit();
+	void endEdit();
+	inline const Tile& getTile(int x, int y) const { return tiles[getIndex(x, y)]; }
 	inline const Tile& getTile(sf::Vector2i coords) const { return getTile(coords.x, coords.y); }
-	inline bool isSolid(sf::Vector2i coords) const { return isWithinBounds(coords) && tiles[coords.y][coords.x].type == Tile::Type::Solid; }
+	inline bool isSolid(int x, int y) const { return collision.isSolid(x, y); }
+	inline bool isSolid(sf::Vector2i coords) const { return collision.isSolid(coords); }
+	// Returns true if any tile inside the given (inclusive position, exclusive size) tile range is solid.
+	// The range is clipped to the map, so tiles outside the map are NOT considered solid here;
+	//  callers that treat out-of-bounds as blocking must check that separately.
+	inline bool anySolidInRect(const sf::IntRect& tileRect) const { return collision.anySolidInRect(tileRect); }
+	// Distance in tiles to the nearest solid tile or map edge (see `CollisionGrid::getClearance()`)
+	inline int getClearance(int x, int y) const { return collision.getClearance(x, y); }
+	inline int getClearance(sf::Vector2i coords) const { return collision.getClearance(coords); }
+	// The clearance a tile needs for a box of the given size to fit anywhere inside it: a tile with
+	//  at least this clearance has no solid tile within the box's reach from any point of it.
+	// Capped at `CollisionGrid::MAX_CLEARANCE + 1`, which no tile has.
+	static int getRequiredClearance(sf::Vector2f size);
+	// Like `getRequiredClearance()`, but for a box centred on the tile, as it is when following a path
+	static int getRequiredClearanceAtCenter(sf::Vector2f size);
+	// Returns true if there may be a path between the tiles (see `CollisionGrid::areConnected()`)
+	inline bool areConnected(sf::Vector2i a, sf::Vector2i b) const { return collision.areConnected(a, b); }
+	// Continues relabelling regions split by earlier changes, see `CollisionGrid::refineRegions()`
+	inline void refineRegions(int maxTiles) { collision.refineRegions(maxTiles); }
+	// Solidity of every tile, which is all that pathfinding needs from the map
+	inline const CollisionGrid& getCollisionGrid() const { return collision; }
 	sf::Color getTileColor(Tile::Type type) const;
 
-	bool isWithinBounds(int x, int y) const;
+	// ---- Change tracking ----
+	// Every `setTile()` that changes a tile's type bumps the revision and is recorded in a
+	//  bounded log, so systems that derive data from the map (e.g. pathfinding graphs) can
+	//  catch up by only looking at the tiles changed since the revision they last saw.
+	inline std::uint64_t getRevision() const { return revision; }
+	// Appends the coordinates of every tile changed after `sinceRevision` to `outChanges`
+	//  (a tile changed several times may appear several times).
+	// Returns false if the log no longer reaches back that far or the map was resized since,
+	//  in which case the caller has to rebuild its data from scratch.
+	bool getChangesSince(std::uint64_t sinceRevision, std::vector<sf::Vector2i>& outChanges) const;
+
+	inline bool isWithinBounds(int x, int y) const { return x >= 0 && x < width && y >= 0 && y < height; }
 	inline bool isWithinBounds(sf::Vector2i coords) const { return isWithinBounds(coords.x, coords.y); }
 	bool collidesWith(const sf::FloatRect& rect) const;
+	// Returns the range of tiles touched by the given world-space rectangle, including
+	//  tiles that only touch its right or bottom edge, grown by `padding` tiles on every side.
+	// May extend outside the map.
+	static sf::IntRect getOverlappedTiles(const sf::FloatRect& rect, int padding = 0);
+
+	// Returns the range of tiles, clamped to the map bounds, that are visible through the given view.
+	// The rectangle's position is the top-left tile and its size is the number of tiles on each axis.
+	// The map is assumed to be drawn with its own transform; a rotated view or map gives the range
+	//  around the tiles that are actually on screen.
+	inline sf::IntRect getVisibleTileRange(const sf::View& view) const { return getVisibleTileRange(view, getTransform()); }
+	// Like the above, for the map drawn with `transform` (local tile space to world space)
+	sf::IntRect getVisibleTileRange(const sf::View& view, const sf::Transform& transform) const;
+
+	// ---- Raycasts ----
+	// Where a ray or a swept box first touched a blocking tile
+	struct RaycastHit
+	{
+		bool isHit = false;
+		sf::Vector2i tile;    // The tile that was hit
+		sf::Vector2f point;   // Where the ray entered the tile, or for `sweepBox()` the box position on contact
+		sf::Vector2f normal;  // Of the face that was hit, pointing back at the ray; zero if it started inside the tile
+		float distance = 0.f; // Along the direction, in pixels
+	};
+	struct Ray
+	{
+		sf::Vector2f origin;
+		sf::Vector2f direction; // Need not be normalised
+		float maxDistance;
+	};
+	// Queries take a set of tile types to stop at, with one bit per type
+	static constexpr std::uint32_t getTileMask(Tile::Type type) { return 1u << static_cast<unsigned>(type); }
+	static constexpr std::uint32_t SOLID_TILE_MASK = 1u << static_cast<unsigned>(Tile::Type::Solid);
+
+	// Finds the first tile in `tileMask` along the ray, at most `maxDistance` pixels from `origin`.
+	// Tiles outside the map are never hit, the ray simply passes through them. A ray starting inside
+	//  a tile in `tileMask` hits it at distance 0. A ray exactly through the corner between tiles is
+	//  only stopped there if both tiles beside the corner are in `tileMask`, so a ray between two
+	//  points is hit or not the same whichever end it is cast from. Returns `outHit.isHit`.
+	bool raycast(sf::Vector2f origin, sf::Vector2f direction, float maxDistance, RaycastHit& outHit, std::uint32_t tileMask = SOLID_TILE_MASK) const;
+	// Casts every ray in turn with the same kernel, one hit per ray in `outHits`
+	void raycast(const std::vector<Ray>& rays, std::vector<RaycastHit>& outHits, std::uint32_t tileMask = SOLID_TILE_MASK) const;
+	// Moves `box` along `direction` until it would overlap a tile in `tileMask`, at most `maxDistance`
+	//  pixels. Touching a tile does not count as overlapping it. Returns `outHit.isHit`.
+	bool sweepBox(const sf::FloatRect& box, sf::Vector2f direction, float maxDistance, RaycastHit& outHit, std::uint32_t tileMask = SOLID_TILE_MASK) const;
 
 	static constexpr float TILE_SIZE = 64.f;
+	static constexpr int CHUNK_SIZE = 32; // Width and height of a render chunk, in tiles
 	bool drawTransparentOnly = false;
 
 private:
+	// `setTile()` without updating the clearance and regions, for changing many tiles at once
+	void writeTile(int x, int y, Tile tile);
+
+	// Draws only the chunks that intersect the target's active view (the GameCamera
+	//  or EditorCamera view), so the cost scales with screen area rather than map area.
+	// Each pass (opaque or translucent, see `drawTransparentOnly`) is a single draw call.
 	virtual void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
 
+	// A CHUNK_SIZE x CHUNK_SIZE block of tiles that owns its own vertices.
+	// Opaque tiles are stored first and translucent tiles after them, so each
+	//  half can be copied into its batch as one contiguous range.
+	struct Chunk
+	{
+		sf::VertexArray vertices{ sf::PrimitiveType::Triangles };
+		std::size_t translucentStart = 0;
+		bool isDirty = true;
+	};
+	void rebuildChunk(int chunkX, int chunkY) const;
+	// Concatenates the vertices of the given chunk range into the opaque and translucent batches.
+	void rebuildBatches(const sf::IntRect& chunkRange) const;
+	inline int getChunkIndex(int x, int y) const { return (y / CHUNK_SIZE) * chunkCount.x + (x / CHUNK_SIZE); }
+
 	bool isGridShown;
 	sf::VertexArray gridLines;
 	sf::Color gridColor;
 
-	std::vector<std::vector<Tile>> tiles;
-	std::vector<sf::RectangleShape> visuals;
+	inline std::size_t getIndex(int x, int y) const { return static_cast<std::size_t>(y) * getStride() + x; }
+
+	// Row-major tile buffer, one byte per tile
+	std::vector<Tile> tiles;
+	int width;
+	int height;
+
+	CollisionGrid collision;
+	sf::Vector2i chunkCount;
+	mutable std::vector<Chunk> chunks; // Rebuilt lazily at draw time
+
+	// Vertices of all currently visible chunks, rebuilt only when the visible
+	//  chunk range changes or one of the visible chunks is modified.
+	mutable sf::VertexArray opaqueBatch;
+	mutable sf::VertexArray translucentBatch;
+	mutable sf::IntRect batchedChunks;
+
+	struct TileChange
+	{
+		std::uint64_t revision;
+		sf::Vector2i position;
+	};
+	static constexpr std::size_t MAX_CHANGE_LOG_SIZE = 4096;
+	std::uint64_t revision;
+	std::uint64_t changeLogStart; // Changes made after this revision are all in `changeLog`
+	std::vector<TileChange> changeLog;
+
+	int editDepth; // Number of `beginEdit()` calls not yet matched by `endEdit()`
 };
\ No newline at end of file
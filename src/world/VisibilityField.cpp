@@ -0,0 +1,121 @@
+// ================================================================================================
+// File: VisibilityField.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cstdlib>
+#include "VisibilityField.hpp"
+
+namespace
+{
+	// `value` / `divisor` rounded down, for a positive divisor
+	int floorDivide(int value, int divisor)
+	{
+		int quotient = value / divisor;
+		return (value % divisor != 0 && value < 0) ? quotient - 1 : quotient;
+	}
+}
+
+VisibilityField::VisibilityField() :
+	origin(0, 0),
+	rows{},
+	isBuilt(false),
+	builtRevision(0)
+{
+}
+
+void VisibilityField::update(const TileMap& tileMap, sf::Vector2i origin)
+{
+	if (isBuilt && origin == this->origin && tileMap.getRevision() == builtRevision)
+		return;
+
+	this->origin = origin;
+	builtRevision = tileMap.getRevision();
+	isBuilt = true;
+	rows.fill(0);
+
+	if (!tileMap.isWithinBounds(origin))
+		return;
+
+	markVisible(tileMap, origin);
+	for (int quadrant = 0; quadrant < 4; ++quadrant)
+		scan(tileMap, quadrant, 1, { -1, 1 }, { 1, 1 });
+}
+
+bool VisibilityField::isVisible(sf::Vector2i tile) const
+{
+	int x = tile.x - origin.x + RANGE;
+	int y = tile.y - origin.y + RANGE;
+	if (x < 0 || y < 0 || x >= SIZE || y >= SIZE)
+		return false;
+	return (rows[y] >> x) & 1u;
+}
+
+void VisibilityField::scan(const TileMap& tileMap, int quadrant, int depth, Slope start, Slope end)
+{
+	if (depth > RANGE)
+		return;
+
+	// Tiles off the map block the view like solid ones
+	auto isWall = [&](sf::Vector2i tile) { return !tileMap.isWithinBounds(tile) || tileMap.isSolid(tile); };
+
+	// Columns whose centres lie within the slopes, rounding ties away from the origin's centre line.
+	// A column's left edge is at slope (2 * column - 1) / (2 * depth).
+	int firstColumn = floorDivide(2 * depth * start.numerator + start.denominator, 2 * start.denominator);
+	int lastColumn = -floorDivide(-2 * depth * end.numerator + end.denominator, 2 * end.denominator);
+
+	bool wasWall = false;
+	bool hasPrevious = false;
+	for (int column = firstColumn; column <= lastColumn; ++column)
+	{
+		sf::Vector2i tile = transform(quadrant, depth, column);
+		bool isTileWall = isWall(tile);
+
+		// A floor tile is only visible if its centre is within the slopes, which keeps the field
+		//  symmetric; walls are visible as soon as any part of them is
+		bool isCentreInside = column * start.denominator >= depth * start.numerator &&
+			column * end.denominator <= depth * end.numerator;
+		if (isTileWall || isCentreInside)
+			markVisible(tileMap, tile);
+
+		if (hasPrevious && wasWall && !isTileWall)
+			start = { 2 * column - 1, 2 * depth };
+		if (hasPrevious && !wasWall && isTileWall)
+			scan(tileMap, quadrant, depth + 1, start, { 2 * column - 1, 2 * depth });
+
+		wasWall = isTileWall;
+		hasPrevious = true;
+	}
+	if (hasPrevious && !wasWall)
+		scan(tileMap, quadrant, depth + 1, start, end);
+}
+
+sf::Vector2i VisibilityField::transform(int quadrant, int depth, int column) const
+{
+	switch (quadrant)
+	{
+	case 0: // Up
+		return { origin.x + column, origin.y - depth };
+	case 1: // Down
+		return { origin.x + column, origin.y + depth };
+	case 2: // Right
+		return { origin.x + depth, origin.y + column };
+	default: // Left
+		return { origin.x - depth, origin.y + column };
+	}
+}
+
+void VisibilityField::markVisible(const TileMap& tileMap, sf::Vector2i tile)
+{
+	if (!tileMap.isWithinBounds(tile))
+		return;
+
+	int x = tile.x - origin.x + RANGE;
+	int y = tile.y - origin.y + RANGE;
+	if (x >= 0 && y >= 0 && x < SIZE && y < SIZE)
+		rows[y] |= std::uint64_t(1) << x;
+}
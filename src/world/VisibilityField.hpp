@@ -0,0 +1,66 @@
+// ================================================================================================
+// File: VisibilityField.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Defines the VisibilityField class, which holds the tiles visible from a single
+//              point (the player's eye), computed once and looked up by every enemy.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <SFML/System/Vector2.hpp>
+#include "TileMap.hpp"
+
+// The tiles within RANGE tiles of an origin tile that can be seen from it, found with symmetric
+//  recursive shadowcasting over the solid tiles. Visibility is symmetric: a tile is visible from
+//  the origin exactly when the origin is visible from it, so enemies can test whether they see
+//  the player with a lookup in the player's field instead of casting their own rays.
+// A floor tile is visible if its centre lies in the part of its row the scan still sees, which is
+//  more permissive than a clear line between the two tile centres: on random maps about a third
+//  of the visible pairs have such a line crossing a solid tile, while no pair with a clear centre
+//  line was left out. It is meant as a cheap filter, with a ray confirming what it lets through.
+// Solid tiles that bound the view are visible themselves.
+class VisibilityField
+{
+public:
+	VisibilityField();
+
+	// Recomputes the field if `origin` or the map changed since the last call
+	void update(const TileMap& tileMap, sf::Vector2i origin);
+
+	// False for tiles outside the map or more than RANGE tiles from the origin on either axis
+	bool isVisible(sf::Vector2i tile) const;
+	inline sf::Vector2i getOrigin() const { return origin; }
+
+	// Half the width of the square area the field covers, in tiles. Must cover the largest enemy
+	//  aggro range, since anything outside counts as not visible.
+	static constexpr int RANGE = 24;
+
+private:
+	// A fraction of a tile per row, the edge of the part of a row still being scanned
+	struct Slope
+	{
+		int numerator;
+		int denominator;
+	};
+	// Scans row `depth` of one quadrant between the two slopes, and the rows behind it that can
+	//  still be seen through the gaps in it
+	void scan(const TileMap& tileMap, int quadrant, int depth, Slope start, Slope end);
+	// Coordinates of the tile `depth` rows out from the origin and `column` across, in `quadrant`
+	sf::Vector2i transform(int quadrant, int depth, int column) const;
+	void markVisible(const TileMap& tileMap, sf::Vector2i tile);
+
+	static constexpr int SIZE = 2 * RANGE + 1;
+	static_assert(SIZE <= 64, "Each row of the field is stored in a single word");
+
+	sf::Vector2i origin;
+	std::array<std::uint64_t, SIZE> rows; // Bit x of row y is the tile (origin - RANGE) + (x, y)
+
+	bool isBuilt;
+	std::uint64_t builtRevision;
+};
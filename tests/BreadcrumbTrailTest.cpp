@@ -0,0 +1,173 @@
+// ================================================================================================
+// File: BreadcrumbTrailTest.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Checks that BreadcrumbTrail cuts loops, keeps its start and stays walkable when
+//              it fills up (also for a box bigger than a tile), and notices when the map blocks it.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "Check.hpp"
+#include "RandomMap.hpp"
+#include "world/BreadcrumbTrail.hpp"
+#include "world/Pathfinding.hpp"
+#include "world/TileMap.hpp"
+
+using Pathfinding::BreadcrumbTrail;
+
+namespace
+{
+	void setSolid(TileMap& map, int x, int y, bool isSolid)
+	{
+		map.setTile(x, y, Tile{ isSolid ? Tile::Type::Solid : Tile::Type::EMPTY });
+	}
+
+	bool isReversedTrail(const BreadcrumbTrail& trail)
+	{
+		std::vector<sf::Vector2i> reversed;
+		trail.getReversed(reversed);
+		if (reversed.size() != trail.getSize())
+			return false;
+		for (std::size_t i = 0; i < reversed.size(); ++i)
+		{
+			if (reversed[i] != trail.getCrumb(trail.getSize() - 1 - i))
+				return false;
+		}
+		return true;
+	}
+
+	// Sweeps a box of `size` centred on each crumb to the next one, returns true if none hits a solid tile
+	bool isClearForBox(const TileMap& map, const BreadcrumbTrail& trail, sf::Vector2f size)
+	{
+		for (std::size_t i = 1; i < trail.getSize(); ++i)
+		{
+			sf::Vector2f from = (sf::Vector2f(trail.getCrumb(i - 1)) + sf::Vector2f(0.5f, 0.5f)) * TileMap::TILE_SIZE;
+			sf::Vector2f to = (sf::Vector2f(trail.getCrumb(i)) + sf::Vector2f(0.5f, 0.5f)) * TileMap::TILE_SIZE;
+			TileMap::RaycastHit hit;
+			if (map.sweepBox(sf::FloatRect(from - size / 2.f, size), to - from, std::hypotf(to.x - from.x, to.y - from.y), hit))
+				return false;
+		}
+		return true;
+	}
+}
+
+int main()
+{
+	// Recording the same tile twice keeps one crumb, and coming back to a tile cuts the loop
+	{
+		TileMap map(10, 10);
+		const CollisionGrid& grid = map.getCollisionGrid();
+		BreadcrumbTrail trail;
+		Test::check(trail.isEmpty(), "a new trail is empty");
+
+		trail.record(grid, sf::Vector2i(1, 1), 1);
+		trail.record(grid, sf::Vector2i(1, 1), 1);
+		Test::check(trail.getSize() == 1, "the same tile twice in a row is one crumb");
+
+		for (sf::Vector2i tile : { sf::Vector2i(2, 1), sf::Vector2i(3, 1), sf::Vector2i(3, 2), sf::Vector2i(2, 1) })
+			trail.record(grid, tile, 1);
+		Test::check(trail.getSize() == 2 && trail.getCrumb(1) == sf::Vector2i(2, 1), "coming back to a tile drops the detour after it");
+
+		trail.clear();
+		Test::check(trail.isEmpty(), "clear() empties the trail");
+	}
+
+	// A trail longer than the buffer is thinned out instead of losing its start
+	{
+		TileMap map(BreadcrumbTrail::CAPACITY * 3, 5);
+		const CollisionGrid& grid = map.getCollisionGrid();
+		BreadcrumbTrail trail;
+		const sf::Vector2i start(0, 2);
+		for (int x = 0; x < map.getWidth(); ++x)
+			trail.record(grid, sf::Vector2i(x, 2 + x % 2), 1);
+
+		Test::check(trail.getSize() <= BreadcrumbTrail::CAPACITY, "a full trail stays within its capacity");
+		Test::check(trail.getCrumb(0) == start, "a thinned trail keeps its start");
+		Test::check(trail.getCrumb(trail.getSize() - 1) == sf::Vector2i(map.getWidth() - 1, 2 + (map.getWidth() - 1) % 2), "a thinned trail keeps its newest crumb");
+		Test::check(trail.isWalkable(grid, 1), "a thinned trail can be walked back");
+		Test::check(isReversedTrail(trail), "getReversed() returns the crumbs newest first");
+
+		// Blocking a line between two crumbs makes the trail unusable
+		sf::Vector2i blocked = trail.getCrumb(trail.getSize() / 2);
+		setSolid(map, blocked.x, blocked.y, true);
+		Test::check(!trail.isWalkable(grid, 1), "a solid tile on the trail makes it unwalkable");
+	}
+
+	// Random walks over random maps: the newest crumb is always the walker's tile, and the trail
+	//  stays walkable with the clearance it was recorded with
+	std::mt19937 generator(7);
+	for (int mapIndex = 0; mapIndex < 50; ++mapIndex)
+	{
+		const int minClearance = mapIndex % 4 == 0 ? 2 : 1;
+		TileMap map = Test::makeRandomMap(generator, { 20, 20 }, { 80, 40 }, 25);
+		const CollisionGrid& grid = map.getCollisionGrid();
+
+		sf::Vector2i tile = Test::randomTile(generator, map);
+		if (grid.getClearance(tile) < minClearance)
+			continue;
+
+		std::string where = "map " + std::to_string(mapIndex);
+		BreadcrumbTrail trail;
+		trail.record(grid, tile, minClearance);
+		bool isNewestCurrent = true;
+		for (int step = 0; step < 2000; ++step)
+		{
+			int direction = static_cast<int>(generator() % 8);
+			sf::Vector2i next(tile.x + CollisionGrid::NEIGHBOR_OFFSETS[direction][0], tile.y + CollisionGrid::NEIGHBOR_OFFSETS[direction][1]);
+			if (!grid.isWithinBounds(next) || !Pathfinding::hasClearLine(grid, tile, next, minClearance))
+				continue;
+
+			tile = next;
+			trail.record(grid, tile, minClearance);
+			isNewestCurrent = isNewestCurrent && trail.getSize() <= BreadcrumbTrail::CAPACITY && trail.getCrumb(trail.getSize() - 1) == tile;
+		}
+		Test::check(isNewestCurrent, where + ": the newest crumb is the current tile");
+		Test::check(trail.isWalkable(grid, minClearance), where + ": the trail can be walked back");
+		Test::check(isReversedTrail(trail), where + ": getReversed() returns the crumbs newest first");
+	}
+
+	// A box bigger than a tile walking around scattered blocks: once thinned, the box centred on the
+	//  trail still fits along every line, recorded with the clearance for anywhere within a tile
+	const sf::Vector2f boxSize(40.f, 40.f);
+	const int boxClearance = TileMap::getRequiredClearance(boxSize);
+	bool isThinned = false;
+	for (int mapIndex = 0; mapIndex < 30; ++mapIndex)
+	{
+		TileMap map = Test::makeRandomMap(generator, { 40, 30 }, { 60, 30 }, 6);
+		const CollisionGrid& grid = map.getCollisionGrid();
+
+		sf::Vector2i tile = Test::randomTile(generator, map);
+		if (grid.getClearance(tile) < boxClearance)
+			continue;
+
+		std::string where = "box map " + std::to_string(mapIndex);
+		BreadcrumbTrail trail;
+		trail.record(grid, tile, boxClearance);
+		bool isBoxClear = true;
+		for (int step = 0; step < 3000; ++step)
+		{
+			int direction = static_cast<int>(generator() % 8);
+			sf::Vector2i next(tile.x + CollisionGrid::NEIGHBOR_OFFSETS[direction][0], tile.y + CollisionGrid::NEIGHBOR_OFFSETS[direction][1]);
+			if (!grid.isWithinBounds(next) || !Pathfinding::hasClearLine(grid, tile, next, boxClearance))
+				continue;
+
+			tile = next;
+			const std::size_t sizeBefore = trail.getSize();
+			trail.record(grid, tile, boxClearance);
+			if (sizeBefore == BreadcrumbTrail::CAPACITY && trail.getSize() < sizeBefore)
+			{
+				isThinned = true;
+				isBoxClear = isBoxClear && isClearForBox(map, trail, boxSize);
+			}
+		}
+		Test::check(isBoxClear && isClearForBox(map, trail, boxSize), where + ": the box fits along every line of the thinned trail");
+	}
+	Test::check(isThinned, "some of the box trails were thinned");
+	return Test::finish();
+}
@@ -0,0 +1,39 @@
+// ================================================================================================
+// File: Check.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: A minimal helper for the tests: records failed checks and turns them into the
+//              exit code ctest looks at.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <iostream>
+#include <string>
+
+namespace Test
+{
+	inline int failureCount = 0;
+
+	// Records a failure (and prints `description`) if `condition` is false
+	inline bool check(bool condition, const std::string& description)
+	{
+		if (!condition)
+		{
+			++failureCount;
+			std::cerr << "FAILED: " << description << '\n';
+		}
+		return condition;
+	}
+
+	// Returns the exit code for main(): 0 if every check passed
+	inline int finish()
+	{
+		if (failureCount > 0)
+			std::cerr << failureCount << " check(s) failed\n";
+		return failureCount == 0 ? 0 : 1;
+	}
+}
@@ -0,0 +1,243 @@
+// ================================================================================================
+// File: CollisionGridTest.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Checks the region labels, clearance and neighbour masks of CollisionGrid against
+//              the tiles after single and batched edits, including splits too large to
+//              relabel right away.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <random>
+#include <string>
+#include <vector>
+#include "Check.hpp"
+#include "RandomMap.hpp"
+#include "world/CollisionGrid.hpp"
+#include "world/TileMap.hpp"
+
+namespace
+{
+	void setSolid(TileMap& map, int x, int y, bool isSolid)
+	{
+		map.setTile(x, y, Tile{ isSolid ? Tile::Type::Solid : Tile::Type::EMPTY });
+	}
+
+	// Labels the connected regions of free tiles from scratch, -1 for solid tiles
+	std::vector<int> floodRegions(const TileMap& map)
+	{
+		const int width = map.getWidth();
+		const int height = map.getHeight();
+		std::vector<int> labels(static_cast<std::size_t>(width) * height, -1);
+		std::vector<sf::Vector2i> queue;
+		int labelCount = 0;
+
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				if (map.isSolid(x, y) || labels[y * width + x] >= 0)
+					continue;
+
+				labels[y * width + x] = labelCount;
+				queue.assign(1, sf::Vector2i(x, y));
+				for (std::size_t i = 0; i < queue.size(); ++i)
+				{
+					for (sf::Vector2i offset : { sf::Vector2i(1, 0), sf::Vector2i(-1, 0), sf::Vector2i(0, 1), sf::Vector2i(0, -1) })
+					{
+						sf::Vector2i neighbor = queue[i] + offset;
+						if (!map.isWithinBounds(neighbor) || map.isSolid(neighbor) || labels[neighbor.y * width + neighbor.x] >= 0)
+							continue;
+						labels[neighbor.y * width + neighbor.x] = labelCount;
+						queue.push_back(neighbor);
+					}
+				}
+				++labelCount;
+			}
+		}
+		return labels;
+	}
+
+	// Tiles in different regions must never share a label. While the grid reports its regions
+	//  as exact, tiles in the same region must share one too.
+	bool areRegionsConsistent(const TileMap& map)
+	{
+		const CollisionGrid& grid = map.getCollisionGrid();
+		const int width = map.getWidth();
+		const int height = map.getHeight();
+		std::vector<int> expected = floodRegions(map);
+
+		// Map each expected region to the label its first tile has, and each label back to the
+		//  first expected region seen with it
+		std::vector<int> labelOfRegion(expected.size(), -2);
+		std::vector<int> regionOfLabel;
+		for (int i = 0; i < width * height; ++i)
+		{
+			int label = grid.getRegion(i % width, i / width);
+			if ((label < 0) != (expected[i] < 0))
+				return false;
+			if (label < 0)
+				continue;
+
+			if (labelOfRegion[expected[i]] == -2)
+				labelOfRegion[expected[i]] = label;
+			else if (labelOfRegion[expected[i]] != label)
+				return false; // One region with two labels
+
+			if (regionOfLabel.size() <= static_cast<std::size_t>(label))
+				regionOfLabel.resize(label + 1, -1);
+			if (regionOfLabel[label] < 0)
+				regionOfLabel[label] = expected[i];
+			else if (regionOfLabel[label] != expected[i] && grid.areRegionsExact())
+				return false; // Two regions with one label
+		}
+		return true;
+	}
+
+	// Clearance and neighbour masks, recomputed by definition for every tile
+	bool areTileCachesConsistent(const TileMap& map)
+	{
+		const CollisionGrid& grid = map.getCollisionGrid();
+		auto isBlocked = [&](int x, int y) { return !map.isWithinBounds({ x, y }) || map.isSolid(x, y); };
+
+		for (int y = 0; y < map.getHeight(); ++y)
+		{
+			for (int x = 0; x < map.getWidth(); ++x)
+			{
+				int clearance = 0;
+				while (clearance < CollisionGrid::MAX_CLEARANCE)
+				{
+					bool isFree = true;
+					for (int dy = -clearance; dy <= clearance && isFree; ++dy)
+					{
+						for (int dx = -clearance; dx <= clearance && isFree; ++dx)
+							isFree = !isBlocked(x + dx, y + dy);
+					}
+					if (!isFree)
+						break;
+					++clearance;
+				}
+				if (grid.getClearance(x, y) != clearance)
+					return false;
+
+				std::uint8_t mask = 0;
+				for (int direction = 0; direction < 8; ++direction)
+				{
+					int dx = CollisionGrid::NEIGHBOR_OFFSETS[direction][0];
+					int dy = CollisionGrid::NEIGHBOR_OFFSETS[direction][1];
+					bool isOpen = !isBlocked(x + dx, y + dy) && (dx == 0 || dy == 0 || (!isBlocked(x + dx, y) && !isBlocked(x, y + dy)));
+					mask |= static_cast<std::uint8_t>(isOpen) << direction;
+				}
+				if (grid.getNeighborMask(x, y) != mask)
+					return false;
+			}
+		}
+		return true;
+	}
+
+	void refineUntilExact(TileMap& map)
+	{
+		for (int call = 0; call < 100000 && !map.getCollisionGrid().areRegionsExact(); ++call)
+			map.refineRegions(64);
+	}
+}
+
+int main()
+{
+	// Two tiles blocking a two tile wide corridor together cut it in two, even though neither
+	//  would on its own
+	{
+		TileMap map(12, 4);
+		for (int x = 0; x < 12; ++x)
+		{
+			setSolid(map, x, 0, true);
+			setSolid(map, x, 3, true);
+		}
+		map.beginEdit();
+		setSolid(map, 5, 1, true);
+		setSolid(map, 5, 2, true);
+		map.endEdit();
+		Test::check(!map.areConnected({ 1, 1 }, { 10, 2 }), "a corridor blocked by a batch of tiles is cut in two");
+		Test::check(areRegionsConsistent(map), "labels after blocking a corridor in one batch");
+	}
+
+	// A wall across a map much larger than MAX_SPLIT_SEARCH_TILES: both halves are too large to
+	//  tell apart right away, so they keep sharing a label until refined
+	{
+		const int size = 200;
+		TileMap map(size, size);
+		for (int y = 0; y < size - 1; ++y)
+			setSolid(map, size / 2, y, true);
+		Test::check(map.areConnected({ 0, 0 }, { size - 1, 0 }), "the halves are joined through the gap");
+
+		setSolid(map, size / 2, size - 1, true);
+		Test::check(!map.getCollisionGrid().areRegionsExact(), "a split too large to search is left for refinement");
+		Test::check(areRegionsConsistent(map), "labels after a large split");
+
+		// Edits while the refinement is under way start it over, but are applied right away
+		map.refineRegions(1000);
+		setSolid(map, 10, 10, true);
+		Test::check(!map.areConnected({ 10, 10 }, { 11, 10 }), "edits during a refinement are applied");
+		refineUntilExact(map);
+		Test::check(map.getCollisionGrid().areRegionsExact(), "refinement finishes");
+		Test::check(!map.areConnected({ 0, 0 }, { size - 1, 0 }), "after refinement the halves have their own labels");
+		Test::check(areRegionsConsistent(map), "labels after refinement");
+
+		// A small room cut off from a large region is told apart right away
+		for (int i = 0; i < 5; ++i)
+		{
+			setSolid(map, 20 + i, 20, true);
+			setSolid(map, 20 + i, 24, true);
+			setSolid(map, 20, 20 + i, true);
+		}
+		for (int i = 0; i < 5; ++i)
+			setSolid(map, 24, 20 + i, true);
+		Test::check(map.getCollisionGrid().areRegionsExact(), "a small room is split off without refinement");
+		Test::check(!map.areConnected({ 22, 22 }, { 0, 0 }), "the room is cut off");
+		Test::check(areRegionsConsistent(map), "labels after closing a room");
+	}
+
+	// Random single and batched edits on small maps
+	std::mt19937 generator(11);
+	for (int mapIndex = 0; mapIndex < 60; ++mapIndex)
+	{
+		TileMap map = Test::makeRandomMap(generator, { 3, 3 }, { 80, 50 }, 60);
+		const int width = map.getWidth();
+		const int height = map.getHeight();
+		const int density = static_cast<int>(generator() % 60); // Of the single tile edits
+
+		for (int round = 0; round < 60; ++round)
+		{
+			if (generator() % 3 == 0)
+			{
+				// A filled or cleared rectangle, like the editor makes
+				int left = static_cast<int>(generator() % width);
+				int top = static_cast<int>(generator() % height);
+				int right = std::min(left + static_cast<int>(generator() % 6), width - 1);
+				int bottom = std::min(top + static_cast<int>(generator() % 6), height - 1);
+				bool isSolid = generator() % 2 == 0;
+				map.beginEdit();
+				for (int y = top; y <= bottom; ++y)
+				{
+					for (int x = left; x <= right; ++x)
+						setSolid(map, x, y, isSolid);
+				}
+				map.endEdit();
+			}
+			else
+				setSolid(map, static_cast<int>(generator() % width), static_cast<int>(generator() % height), static_cast<int>(generator() % 100) < density);
+
+			if (round % 5 == 0)
+			{
+				std::string where = "map " + std::to_string(mapIndex) + " round " + std::to_string(round);
+				Test::check(areRegionsConsistent(map), where + ": labels match a flood fill");
+				Test::check(areTileCachesConsistent(map), where + ": clearance and neighbour masks match the tiles");
+				refineUntilExact(map);
+				Test::check(map.getCollisionGrid().areRegionsExact() && areRegionsConsistent(map), where + ": labels match a flood fill after refinement");
+			}
+		}
+	}
+	return Test::finish();
+}
@@ -0,0 +1,116 @@
+// ================================================================================================
+// File: DStarLiteTest.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Checks that DStarLite finds paths of the same cost as A* while its endpoints
+//              move and tiles change between queries.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "Check.hpp"
+#include "RandomMap.hpp"
+#include "world/DStarLite.hpp"
+#include "world/Pathfinding.hpp"
+#include "world/TileMap.hpp"
+
+namespace
+{
+	float getPathCost(sf::Vector2i start, const std::vector<sf::Vector2i>& path)
+	{
+		float cost = 0.f;
+		for (sf::Vector2i tile : path)
+		{
+			cost += (tile.x != start.x && tile.y != start.y) ? 1.414f : 1.f;
+			start = tile;
+		}
+		return cost;
+	}
+
+	// Same movement rules as `findPathAStar()`: single steps onto free tiles, no cutting corners
+	bool isPathLegal(const CollisionGrid& grid, sf::Vector2i start, const std::vector<sf::Vector2i>& path)
+	{
+		for (sf::Vector2i tile : path)
+		{
+			int dx = tile.x - start.x;
+			int dy = tile.y - start.y;
+			if (std::abs(dx) > 1 || std::abs(dy) > 1 || (dx == 0 && dy == 0) || grid.isSolid(tile))
+				return false;
+			if (dx != 0 && dy != 0 && (grid.isSolid(start.x + dx, start.y) || grid.isSolid(start.x, start.y + dy)))
+				return false;
+			start = tile;
+		}
+		return true;
+	}
+}
+
+int main()
+{
+	{
+		Pathfinding::DStarLite planner;
+		std::vector<sf::Vector2i> path;
+		Test::check(!planner.isFinished(), "a planner is not finished before its first update");
+		Test::check(!planner.getPath(path), "a planner has no path before its first update");
+	}
+
+	std::mt19937 generator(5);
+	for (int mapIndex = 0; mapIndex < 20; ++mapIndex)
+	{
+		TileMap map = Test::makeRandomMap(generator, { 20, 15 }, { 40, 25 }, 35);
+		auto randomTile = [&]() { return Test::randomTile(generator, map); };
+
+		Pathfinding::DStarLite planner;
+		sf::Vector2i start = randomTile();
+		sf::Vector2i goal = randomTile();
+		std::vector<sf::Vector2i> plannedPath;
+		std::vector<sf::Vector2i> expectedPath;
+
+		for (int step = 0; step < 40; ++step)
+		{
+			// Walk along the last path, nudge the goal, flip a few tiles or jump somewhere else
+			int change = static_cast<int>(generator() % 10);
+			if (change < 4 && !plannedPath.empty())
+				start = plannedPath[std::min<std::size_t>(plannedPath.size() - 1, generator() % 3)];
+			else if (change < 7)
+			{
+				sf::Vector2i moved = goal + sf::Vector2i(static_cast<int>(generator() % 5) - 2, static_cast<int>(generator() % 5) - 2);
+				if (map.isWithinBounds(moved))
+					goal = moved;
+			}
+			else if (change < 9)
+			{
+				sf::Vector2i tile = randomTile();
+				map.setTile(tile.x, tile.y, Tile{ map.isSolid(tile) ? Tile::Type::EMPTY : Tile::Type::Solid });
+			}
+			else
+				start = randomTile();
+
+			// Small budgets now and then, so searches spread over several updates are covered too
+			int budget = generator() % 4 == 0 ? 1 + static_cast<int>(generator() % 40) : 1000000;
+			planner.setEndpoints(start, goal);
+			do
+				planner.update(map, budget);
+			while (!planner.isFinished());
+
+			bool isPlannedFound = planner.getPath(plannedPath);
+			bool isExpectedFound = Pathfinding::findPathAStar(map.getCollisionGrid(), start, goal, expectedPath);
+
+			std::string query = "map " + std::to_string(mapIndex) + " step " + std::to_string(step);
+			if (!Test::check(isPlannedFound == isExpectedFound, query + ": D* Lite and A* agree on whether there is a path") || !isPlannedFound)
+			{
+				plannedPath.clear();
+				continue;
+			}
+			Test::check(std::fabs(getPathCost(start, plannedPath) - getPathCost(start, expectedPath)) < 0.001f, query + ": the path costs as much as A*'s");
+			Test::check(isPathLegal(map.getCollisionGrid(), start, plannedPath), query + ": the path only takes legal steps");
+			Test::check(plannedPath.empty() ? start == goal : plannedPath.back() == goal, query + ": the path ends on the goal");
+		}
+	}
+	return Test::finish();
+}
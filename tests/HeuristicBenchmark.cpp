@@ -0,0 +1,104 @@
+// ================================================================================================
+// File: HeuristicBenchmark.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Times A* with the Euclidean heuristic against the landmark heuristic on random
+//              pairs of connected tiles of a generated maze. Not run by ctest; run it by hand
+//              (optionally with the number of queries) when changing either heuristic.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <algorithm>
+#include "core/Constants.hpp"
+#include "world/LandmarkTable.hpp"
+#include "world/Pathfinding.hpp"
+#include "world/TileMap.hpp"
+
+namespace
+{
+	using Clock = std::chrono::steady_clock;
+
+	float millisecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<float, std::milli>(Clock::now() - start).count();
+	}
+
+	// Walls every few columns with a single gap, alternating between top and bottom, so most
+	//  routes double back and the straight-line estimate is far off. Scattered blocks on top.
+	void buildMaze(TileMap& map, std::mt19937& generator)
+	{
+		constexpr int WALL_SPACING = 16;
+		constexpr int GAP_HEIGHT = 4;
+		std::bernoulli_distribution isBlock(0.15);
+
+		map.beginEdit();
+		for (int x = 0; x < map.getWidth(); ++x)
+		{
+			const bool isWall = x % WALL_SPACING == WALL_SPACING - 1;
+			const bool isGapAtTop = (x / WALL_SPACING) % 2 == 0;
+			for (int y = 0; y < map.getHeight(); ++y)
+			{
+				const bool isGap = isGapAtTop ? y < GAP_HEIGHT : y >= map.getHeight() - GAP_HEIGHT;
+				const bool isSolid = isWall ? !isGap : isBlock(generator);
+				map.setTile(x, y, Tile{ isSolid ? Tile::Type::Solid : Tile::Type::EMPTY });
+			}
+		}
+		map.endEdit();
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	const int queryCount = argc > 1 ? std::max(std::stoi(argv[1]), 1) : 200;
+
+	// Fixed seed, so runs can be compared
+	std::mt19937 generator(19);
+	TileMap map(512, 128);
+	buildMaze(map, generator);
+	const CollisionGrid& grid = map.getCollisionGrid();
+
+	Pathfinding::LandmarkTable table;
+	Clock::time_point buildStart = Clock::now();
+	table.build(grid, map.getRevision(), lv::Constants::PATHFINDING_LANDMARK_COUNT);
+	const float buildMilliseconds = millisecondsSince(buildStart);
+
+	std::uniform_int_distribution<int> randomX(0, grid.getWidth() - 1);
+	std::uniform_int_distribution<int> randomY(0, grid.getHeight() - 1);
+	std::vector<std::pair<sf::Vector2i, sf::Vector2i>> queries;
+	for (int attempt = 0; attempt < queryCount * 100 && static_cast<int>(queries.size()) < queryCount; ++attempt)
+	{
+		sf::Vector2i start(randomX(generator), randomY(generator));
+		sf::Vector2i goal(randomX(generator), randomY(generator));
+		if (start != goal && !grid.isSolid(start.x, start.y) && grid.areConnected(start, goal))
+			queries.emplace_back(start, goal);
+	}
+	if (queries.empty())
+	{
+		std::cout << "No connected tiles to search between\n";
+		return 1;
+	}
+
+	std::vector<sf::Vector2i> path;
+	auto timeQueries = [&](Pathfinding::Algorithm algorithm)
+		{
+			Clock::time_point start = Clock::now();
+			for (const auto& [from, to] : queries)
+				Pathfinding::findPath(grid, from, to, path, algorithm, 1, &table);
+			return millisecondsSince(start) / queries.size();
+		};
+	const float euclidean = timeQueries(Pathfinding::Algorithm::AStar);
+	const float landmark = timeQueries(Pathfinding::Algorithm::AStarLandmarks);
+
+	std::cout << queries.size() << " queries on " << grid.getWidth() << "x" << grid.getHeight() << ", " << table.getLandmarkCount()
+		<< " landmarks built in " << buildMilliseconds << " ms\n"
+		<< "Euclidean: " << euclidean << " ms/query\n"
+		<< "Landmarks: " << landmark << " ms/query (" << euclidean / std::max(landmark, 0.0001f) << "x)\n";
+	return 0;
+}
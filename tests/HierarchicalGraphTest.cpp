@@ -0,0 +1,206 @@
+// ================================================================================================
+// File: HierarchicalGraphTest.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Checks that HierarchicalGraph links its entrances both ways across cluster borders,
+//              finds a path exactly when findPathAStar() does, made of valid steps, and that a graph
+//              kept up to date with update() matches one built fresh after random edits.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <unordered_map>
+#include "Check.hpp"
+#include "RandomMap.hpp"
+#include "world/HierarchicalGraph.hpp"
+#include "world/Pathfinding.hpp"
+#include "world/TileMap.hpp"
+
+using Pathfinding::HierarchicalGraph;
+
+namespace
+{
+	constexpr int CLUSTER = HierarchicalGraph::CLUSTER_SIZE;
+
+	void setType(TileMap& map, int x, int y, Tile::Type type)
+	{
+		map.setTile(x, y, Tile{ type });
+	}
+
+	bool isSameCluster(sf::Vector2i a, sf::Vector2i b)
+	{
+		return a.x / CLUSTER == b.x / CLUSTER && a.y / CLUSTER == b.y / CLUSTER;
+	}
+
+	// Every step moves to a free neighbour, diagonals only past free corner tiles, and the last one
+	//  ends on the goal
+	bool isValidPath(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, const std::vector<sf::Vector2i>& path)
+	{
+		sf::Vector2i from = start;
+		for (sf::Vector2i tile : path)
+		{
+			sf::Vector2i step = tile - from;
+			if (std::abs(step.x) > 1 || std::abs(step.y) > 1 || step == sf::Vector2i(0, 0) || !grid.isWithinBounds(tile) || grid.isSolid(tile))
+				return false;
+			if (step.x != 0 && step.y != 0 && (grid.isSolid(from.x + step.x, from.y) || grid.isSolid(from.x, from.y + step.y)))
+				return false;
+			from = tile;
+		}
+		return from == goal;
+	}
+
+	// Entrances are free tiles, each partner is a free tile right across a cluster border that lists
+	//  the entrance back, and the costs inside a cluster are the same both ways
+	bool isConsistent(const CollisionGrid& grid, const std::vector<HierarchicalGraph::Entrance>& entrances)
+	{
+		std::unordered_map<int, const HierarchicalGraph::Entrance*> byTile;
+		for (const HierarchicalGraph::Entrance& entrance : entrances)
+			byTile[entrance.tile.y * grid.getWidth() + entrance.tile.x] = &entrance;
+		auto find = [&](sf::Vector2i tile) -> const HierarchicalGraph::Entrance*
+			{
+				auto it = byTile.find(tile.y * grid.getWidth() + tile.x);
+				return it != byTile.end() ? it->second : nullptr;
+			};
+
+		for (const HierarchicalGraph::Entrance& entrance : entrances)
+		{
+			if (grid.isSolid(entrance.tile))
+				return false;
+
+			for (sf::Vector2i partner : entrance.partners)
+			{
+				sf::Vector2i offset = partner - entrance.tile;
+				const HierarchicalGraph::Entrance* other = find(partner);
+				if (std::abs(offset.x) + std::abs(offset.y) != 1 || isSameCluster(entrance.tile, partner) || other == nullptr ||
+					std::find(other->partners.begin(), other->partners.end(), entrance.tile) == other->partners.end())
+					return false;
+			}
+
+			for (const auto& [tile, cost] : entrance.costs)
+			{
+				const HierarchicalGraph::Entrance* other = find(tile);
+				if (!isSameCluster(entrance.tile, tile) || other == nullptr ||
+					std::find(other->costs.begin(), other->costs.end(), std::make_pair(entrance.tile, cost)) == other->costs.end())
+					return false;
+			}
+		}
+		return true;
+	}
+
+	bool isSameEntrances(const std::vector<HierarchicalGraph::Entrance>& a, const std::vector<HierarchicalGraph::Entrance>& b)
+	{
+		return std::equal(a.begin(), a.end(), b.begin(), b.end(), [](const HierarchicalGraph::Entrance& x, const HierarchicalGraph::Entrance& y)
+			{
+				return x.tile == y.tile && x.partners == y.partners && x.costs == y.costs;
+			});
+	}
+}
+
+int main()
+{
+	// A wall along the border between two clusters, open on a single row: one entrance on each side
+	{
+		TileMap map(2 * CLUSTER, CLUSTER);
+		for (int y = 0; y < CLUSTER; ++y)
+		{
+			if (y != 5)
+				setType(map, CLUSTER, y, Tile::Type::Solid);
+		}
+		const CollisionGrid& grid = map.getCollisionGrid();
+		HierarchicalGraph graph;
+		graph.update(map);
+
+		std::vector<HierarchicalGraph::Entrance> entrances;
+		graph.getEntrances(entrances);
+		Test::check(graph.getNodeCount() == 2 && entrances.size() == 2, "a single gap gives one entrance on each side");
+		Test::check(entrances.size() == 2 && entrances[0].tile == sf::Vector2i(CLUSTER - 1, 5) && entrances[1].tile == sf::Vector2i(CLUSTER, 5) &&
+			entrances[0].partners == std::vector<sf::Vector2i>{ entrances[1].tile } && entrances[1].partners == std::vector<sf::Vector2i>{ entrances[0].tile },
+			"the two entrances face each other across the gap and are partners");
+
+		std::vector<sf::Vector2i> path;
+		Test::check(graph.findPath(grid, { 2, 12 }, { 2 * CLUSTER - 2, 12 }, path) && isValidPath(grid, { 2, 12 }, { 2 * CLUSTER - 2, 12 }, path) &&
+			std::find(path.begin(), path.end(), sf::Vector2i(CLUSTER, 5)) != path.end(), "the path goes through the gap");
+
+		// Closing the gap removes both entrances, and with them every path across
+		setType(map, CLUSTER, 5, Tile::Type::Solid);
+		graph.update(map);
+		Test::check(graph.getNodeCount() == 0, "closing the gap removes its entrances");
+		Test::check(!graph.findPath(grid, { 2, 12 }, { 2 * CLUSTER - 2, 12 }, path) && path.empty(), "no path is found through a closed wall");
+	}
+
+	// Random maps: the graph is consistent and finds a path exactly when A* does, and after every
+	//  round of random edits the updated graph matches a fresh one, entrance for entrance
+	std::mt19937 generator(23);
+	int foundCount = 0;
+	int notFoundCount = 0;
+	for (int mapIndex = 0; mapIndex < 60; ++mapIndex)
+	{
+		TileMap map = Test::makeRandomMap(generator, { 5, 5 }, { 120, 80 }, 40);
+		const CollisionGrid& grid = map.getCollisionGrid();
+		HierarchicalGraph graph;
+		graph.update(map);
+
+		for (int round = 0; round < 4; ++round)
+		{
+			std::string where = "map " + std::to_string(mapIndex) + " round " + std::to_string(round);
+			HierarchicalGraph fresh;
+			fresh.update(map);
+
+			std::vector<HierarchicalGraph::Entrance> entrances;
+			std::vector<HierarchicalGraph::Entrance> freshEntrances;
+			graph.getEntrances(entrances);
+			fresh.getEntrances(freshEntrances);
+			Test::check(isConsistent(grid, entrances), where + ": entrances are free and their partners and costs go both ways");
+			Test::check(graph.getNodeCount() == fresh.getNodeCount() && isSameEntrances(entrances, freshEntrances),
+				where + ": the updated graph has the same entrances, partners and costs as a fresh one");
+
+			bool isFoundSame = true;
+			bool isEveryPathValid = true;
+			bool isSameAsFresh = true;
+			for (int query = 0; query < 25; ++query)
+			{
+				sf::Vector2i start = Test::randomTile(generator, map);
+				sf::Vector2i goal = Test::randomTile(generator, map);
+
+				std::vector<sf::Vector2i> aStarPath;
+				std::vector<sf::Vector2i> path;
+				std::vector<sf::Vector2i> freshPath;
+				int expansions = 0;
+				int freshExpansions = 0;
+				bool isAStarFound = Pathfinding::findPathAStar(grid, start, goal, aStarPath);
+				bool isFound = graph.findPath(grid, start, goal, path, &expansions);
+				bool isFreshFound = fresh.findPath(grid, start, goal, freshPath, &freshExpansions);
+
+				isFoundSame = isFoundSame && isFound == isAStarFound;
+				isEveryPathValid = isEveryPathValid && (isFound ? isValidPath(grid, start, goal, path) : path.empty());
+				isSameAsFresh = isSameAsFresh && isFound == isFreshFound && path == freshPath && expansions == freshExpansions;
+				++(isAStarFound ? foundCount : notFoundCount);
+			}
+			Test::check(isFoundSame, where + ": a path is found exactly when A* finds one");
+			Test::check(isEveryPathValid, where + ": paths are made of valid steps and end on the goal");
+			Test::check(isSameAsFresh, where + ": the updated graph finds the same paths as a fresh one");
+
+			// Some edits in one batch, some one at a time
+			const int editCount = 1 + static_cast<int>(generator() % 30);
+			const bool isBatch = round % 2 == 0;
+			if (isBatch)
+				map.beginEdit();
+			for (int edit = 0; edit < editCount; ++edit)
+			{
+				sf::Vector2i tile = Test::randomTile(generator, map);
+				setType(map, tile.x, tile.y, generator() % 2 == 0 ? Tile::Type::Solid : Tile::Type::EMPTY);
+			}
+			if (isBatch)
+				map.endEdit();
+			graph.update(map);
+		}
+	}
+	Test::check(foundCount > 0 && notFoundCount > 0, "the random queries cover found and not found");
+	return Test::finish();
+}
@@ -0,0 +1,131 @@
+// ================================================================================================
+// File: JumpPointSearchTest.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Checks that Pathfinding::findPathJPS() finds a path exactly when findPathAStar()
+//              does, of the same cost and made of valid steps, for any clearance and from solid
+//              start tiles.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cmath>
+#include <cstdlib>
+#include <random>
+#include <string>
+#include <vector>
+#include "Check.hpp"
+#include "RandomMap.hpp"
+#include "world/Pathfinding.hpp"
+#include "world/TileMap.hpp"
+
+namespace
+{
+	void setSolid(TileMap& map, int x, int y)
+	{
+		map.setTile(x, y, Tile{ Tile::Type::Solid });
+	}
+
+	// Sum of the step costs along a path that does not include its start
+	float getPathCost(sf::Vector2i start, const std::vector<sf::Vector2i>& path)
+	{
+		float cost = 0.f;
+		for (sf::Vector2i tile : path)
+		{
+			sf::Vector2i step = tile - start;
+			cost += step.x != 0 && step.y != 0 ? 1.414f : 1.f;
+			start = tile;
+		}
+		return cost;
+	}
+
+	// Every step moves to one of the 8 neighbours with enough clearance, diagonals only past open
+	//  corner tiles, and the last one ends on the goal
+	bool isValidPath(const CollisionGrid& grid, sf::Vector2i start, sf::Vector2i goal, const std::vector<sf::Vector2i>& path, int minClearance)
+	{
+		if (path.empty())
+			return start == goal;
+
+		sf::Vector2i from = start;
+		for (sf::Vector2i tile : path)
+		{
+			sf::Vector2i step = tile - from;
+			if (std::abs(step.x) > 1 || std::abs(step.y) > 1 || step == sf::Vector2i(0, 0) || grid.getClearance(tile) < minClearance)
+				return false;
+			if (step.x != 0 && step.y != 0 &&
+				(grid.getClearance(from.x + step.x, from.y) < minClearance || grid.getClearance(from.x, from.y + step.y) < minClearance))
+				return false;
+			from = tile;
+		}
+		return from == goal;
+	}
+}
+
+int main()
+{
+	// A one tile wide gap lets a small mover through but not one that needs more room
+	{
+		TileMap map(12, 9);
+		for (int y = 0; y < 9; ++y)
+		{
+			if (y != 4)
+				setSolid(map, 6, y);
+		}
+		const CollisionGrid& grid = map.getCollisionGrid();
+		std::vector<sf::Vector2i> path;
+		Test::check(Pathfinding::findPathJPS(grid, { 2, 4 }, { 10, 4 }, path, 1) && isValidPath(grid, { 2, 4 }, { 10, 4 }, path, 1),
+			"a path goes through the gap");
+		Test::check(!Pathfinding::findPathJPS(grid, { 2, 4 }, { 10, 4 }, path, 2) && path.empty(), "no path fits a mover needing clearance 2");
+
+		// Starting inside the wall, the search can still step out of it
+		Test::check(Pathfinding::findPathJPS(grid, { 6, 2 }, { 10, 4 }, path, 1) && isValidPath(grid, { 6, 2 }, { 10, 4 }, path, 1),
+			"a path is found from a solid start tile");
+	}
+
+	// Random maps: JPS finds a path exactly when A* does, with the same cost and only valid steps
+	std::mt19937 generator(17);
+	int foundCount = 0;
+	int notFoundCount = 0;
+	int solidStartCount = 0;
+	for (int mapIndex = 0; mapIndex < 120; ++mapIndex)
+	{
+		const int minClearance = 1 + mapIndex % 3;
+		TileMap map = Test::makeRandomMap(generator, { 5, 5 }, { 80, 50 }, minClearance == 1 ? 45 : 20);
+		const CollisionGrid& grid = map.getCollisionGrid();
+		std::string where = "map " + std::to_string(mapIndex) + " (clearance " + std::to_string(minClearance) + ")";
+
+		bool isFoundSame = true;
+		bool isCostSame = true;
+		bool isEveryPathValid = true;
+		for (int query = 0; query < 40; ++query)
+		{
+			sf::Vector2i start = Test::randomTile(generator, map);
+			sf::Vector2i goal = Test::randomTile(generator, map);
+			if (grid.isSolid(start))
+				++solidStartCount;
+
+			std::vector<sf::Vector2i> aStarPath;
+			std::vector<sf::Vector2i> jpsPath;
+			bool isAStarFound = Pathfinding::findPathAStar(grid, start, goal, aStarPath, minClearance);
+			bool isJpsFound = Pathfinding::findPathJPS(grid, start, goal, jpsPath, minClearance);
+			isFoundSame = isFoundSame && isAStarFound == isJpsFound;
+			if (!isAStarFound || !isJpsFound)
+			{
+				++notFoundCount;
+				isEveryPathValid = isEveryPathValid && (isJpsFound || jpsPath.empty());
+				continue;
+			}
+
+			++foundCount;
+			float aStarCost = getPathCost(start, aStarPath);
+			isCostSame = isCostSame && std::fabs(aStarCost - getPathCost(start, jpsPath)) <= 1.0e-3f * (1.f + aStarCost);
+			isEveryPathValid = isEveryPathValid && isValidPath(grid, start, goal, jpsPath, minClearance);
+		}
+		Test::check(isFoundSame, where + ": JPS finds a path exactly when A* does");
+		Test::check(isCostSame, where + ": JPS paths cost the same as A* paths");
+		Test::check(isEveryPathValid, where + ": JPS paths are made of valid steps and end on the goal");
+	}
+	Test::check(foundCount > 0 && notFoundCount > 0 && solidStartCount > 0, "the random queries cover found, not found and solid starts");
+	return Test::finish();
+}
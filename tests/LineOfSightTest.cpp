@@ -0,0 +1,224 @@
+// ================================================================================================
+// File: LineOfSightTest.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Checks Utility::hasLineOfSight() to a point and to a rectangle, and
+//              Utility::hasLineOfSightWithClearance(), against plain segment-against-every-solid-tile
+//              tests, on hand-made cases and random maps.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <algorithm>
+#include "Check.hpp"
+#include "RandomMap.hpp"
+#include "core/Utility.hpp"
+#include "world/TileMap.hpp"
+
+namespace
+{
+	constexpr float TILE = TileMap::TILE_SIZE;
+
+	enum class Reference { Clear, Blocked, Unsure };
+
+	void setSolid(TileMap& map, int x, int y)
+	{
+		map.setTile(x, y, Tile{ Tile::Type::Solid });
+	}
+
+	// Length of the part of the segment from `a` to `b` inside the box, 0 if it misses (Liang-Barsky)
+	float getLengthInBox(sf::Vector2f a, sf::Vector2f b, sf::Vector2f boxMin, sf::Vector2f boxMax)
+	{
+		float enter = 0.f;
+		float leave = 1.f;
+		const float from[2] = { a.x, a.y };
+		const float delta[2] = { b.x - a.x, b.y - a.y };
+		const float low[2] = { boxMin.x, boxMin.y };
+		const float high[2] = { boxMax.x, boxMax.y };
+		for (int axis = 0; axis < 2; ++axis)
+		{
+			if (delta[axis] == 0.f)
+			{
+				if (from[axis] <= low[axis] || from[axis] >= high[axis])
+					return 0.f;
+				continue;
+			}
+			float t0 = (low[axis] - from[axis]) / delta[axis];
+			float t1 = (high[axis] - from[axis]) / delta[axis];
+			enter = std::max(enter, std::min(t0, t1));
+			leave = std::min(leave, std::max(t0, t1));
+		}
+		return enter < leave ? (leave - enter) * std::hypotf(b.x - a.x, b.y - a.y) : 0.f;
+	}
+
+	// Longest part of the segment inside a single solid tile grown by `margin` on every side
+	float getLengthInSolid(const TileMap& map, sf::Vector2f a, sf::Vector2f b, sf::Vector2f margin)
+	{
+		float longest = 0.f;
+		for (int y = 0; y < map.getHeight(); ++y)
+		{
+			for (int x = 0; x < map.getWidth(); ++x)
+			{
+				sf::Vector2f tileMin(x * TILE - margin.x, y * TILE - margin.y);
+				sf::Vector2f tileMax((x + 1) * TILE + margin.x, (y + 1) * TILE + margin.y);
+				if (map.isSolid(x, y))
+					longest = std::max(longest, getLengthInBox(a, b, tileMin, tileMax));
+			}
+		}
+		return longest;
+	}
+
+	bool crossesSolid(const TileMap& map, sf::Vector2f a, sf::Vector2f b, float margin)
+	{
+		return getLengthInSolid(map, a, b, { margin, margin }) > 0.f;
+	}
+
+	// Lines that only graze a solid tile, within rounding of its edge or corner, could go either way
+	Reference referenceLine(const TileMap& map, sf::Vector2f a, sf::Vector2f b)
+	{
+		constexpr float EDGE = 0.01f;
+		if (crossesSolid(map, a, b, -EDGE))
+			return Reference::Blocked;
+		if (!crossesSolid(map, a, b, EDGE))
+			return Reference::Clear;
+		return Reference::Unsure;
+	}
+
+	Reference referenceRect(const TileMap& map, sf::Vector2f from, sf::FloatRect rect)
+	{
+		Reference result = Reference::Blocked;
+		for (sf::Vector2f corner : { rect.position, rect.position + sf::Vector2f(rect.size.x, 0.f),
+			rect.position + sf::Vector2f(0.f, rect.size.y), rect.position + rect.size })
+		{
+			Reference line = referenceLine(map, from, corner);
+			if (line == Reference::Clear)
+				return Reference::Clear;
+			if (line == Reference::Unsure)
+				result = Reference::Unsure;
+		}
+		return result;
+	}
+
+	// A box of `size` centred on the segment hits a solid tile (or the map's edge) where the segment
+	//  runs through that tile grown by half the box. The check only samples the segment every
+	//  CLEARANCE_STEP, so it is sure to notice a hit that lasts longer than that, and none at all
+	//  if the box never touches anything; anything in between could go either way.
+	Reference referenceClearance(const TileMap& map, sf::Vector2f from, sf::Vector2f to, sf::Vector2f size)
+	{
+		constexpr float CLEARANCE_STEP = TILE / 3.f;
+		constexpr float EDGE = 0.01f;
+		constexpr float OUTSIDE = 1.0e6f;
+		const sf::Vector2f mapSize(map.getWidth() * TILE, map.getHeight() * TILE);
+
+		auto getLongestHit = [&](float margin)
+			{
+				sf::Vector2f grown = size / 2.f + sf::Vector2f(margin, margin);
+				float longest = getLengthInSolid(map, from, to, grown);
+				// Past the edge of the map, as four boxes around it
+				longest = std::max(longest, getLengthInBox(from, to, { -OUTSIDE, -OUTSIDE }, { grown.x, OUTSIDE }));
+				longest = std::max(longest, getLengthInBox(from, to, { mapSize.x - grown.x, -OUTSIDE }, { OUTSIDE, OUTSIDE }));
+				longest = std::max(longest, getLengthInBox(from, to, { -OUTSIDE, -OUTSIDE }, { OUTSIDE, grown.y }));
+				longest = std::max(longest, getLengthInBox(from, to, { -OUTSIDE, mapSize.y - grown.y }, { OUTSIDE, OUTSIDE }));
+				return longest;
+			};
+
+		if (getLongestHit(-EDGE) > CLEARANCE_STEP + EDGE)
+			return Reference::Blocked;
+		if (getLongestHit(EDGE) == 0.f)
+			return Reference::Clear;
+		return Reference::Unsure;
+	}
+}
+
+int main()
+{
+	// A wall in column 5 from row 4 down, the player behind it
+	{
+		TileMap map(12, 8);
+		for (int y = 4; y < 8; ++y)
+			setSolid(map, 5, y);
+
+		const sf::Vector2f eye(1.5f * TILE, 6.5f * TILE);
+		const sf::Vector2f playerSize(0.5f * TILE, 1.5f * TILE);
+		Test::check(!Utility::hasLineOfSight(eye, sf::FloatRect({ 8.f * TILE, 5.f * TILE }, playerSize), map),
+			"a player fully behind the wall is not seen");
+		Test::check(Utility::hasLineOfSight(eye, sf::FloatRect({ 8.f * TILE, 1.f * TILE }, playerSize), map),
+			"a player whose top corners can be seen over the wall is seen");
+		Test::check(!Utility::hasLineOfSight(eye, sf::Vector2f(8.f * TILE, 1.f * TILE) + playerSize / 2.f, map),
+			"the centre of that player is still hidden");
+		Test::check(Utility::hasLineOfSight(sf::Vector2f(1.5f * TILE, 1.5f * TILE), sf::FloatRect({ 3.f * TILE, 1.f * TILE }, playerSize), map),
+			"a player in the open next to the eye is seen");
+	}
+
+	// A box too tall for a gap in a wall cannot move through it, a small one can
+	{
+		TileMap map(12, 8);
+		for (int y = 0; y < 8; ++y)
+		{
+			if (y != 4)
+				setSolid(map, 6, y);
+		}
+		const sf::Vector2f from(2.5f * TILE, 4.5f * TILE);
+		const sf::Vector2f to(10.5f * TILE, 4.5f * TILE);
+		Test::check(Utility::hasLineOfSightWithClearance(from, to, { 0.5f * TILE, 0.5f * TILE }, map), "a box smaller than the gap fits through it");
+		Test::check(!Utility::hasLineOfSightWithClearance(from, to, { 0.5f * TILE, 1.5f * TILE }, map), "a box taller than the gap does not");
+		Test::check(!Utility::hasLineOfSightWithClearance({ 2.5f * TILE, 0.1f * TILE }, { 4.5f * TILE, 0.1f * TILE }, { 0.5f * TILE, 0.5f * TILE }, map),
+			"a box sticking out of the map is blocked");
+	}
+
+	// Random maps: every check agrees with the reference wherever it is sure
+	std::mt19937 generator(13);
+	std::uniform_real_distribution<float> unit(0.f, 1.f);
+	for (int mapIndex = 0; mapIndex < 40; ++mapIndex)
+	{
+		TileMap map = Test::makeRandomMap(generator, { 10, 10 }, { 40, 30 }, 35);
+		const float width = map.getWidth() * TILE;
+		const float height = map.getHeight() * TILE;
+		std::string where = "map " + std::to_string(mapIndex);
+
+		bool isPointSame = true;
+		bool isRectSame = true;
+		bool isClearanceSame = true;
+		int rectCount = 0;
+		int clearanceCount = 0;
+		for (int query = 0; query < 300; ++query)
+		{
+			sf::Vector2f from(unit(generator) * width, unit(generator) * height);
+			if (map.isSolid(static_cast<int>(from.x / TILE), static_cast<int>(from.y / TILE)))
+				continue;
+
+			sf::Vector2f to(unit(generator) * width, unit(generator) * height);
+			Reference line = referenceLine(map, from, to);
+			// Lines under a pixel long count as clear without being traced
+			if (line != Reference::Unsure && std::hypotf(to.x - from.x, to.y - from.y) >= 1.f)
+				isPointSame = isPointSame && Utility::hasLineOfSight(from, to, map) == (line == Reference::Clear);
+
+			// Rectangles kept inside the map, since the line of sight never leaves it
+			sf::Vector2f size(4.f + unit(generator) * 60.f, 4.f + unit(generator) * 60.f);
+			sf::FloatRect rect({ unit(generator) * (width - size.x), unit(generator) * (height - size.y) }, size);
+			Reference visible = referenceRect(map, from, rect);
+			if (visible != Reference::Unsure)
+			{
+				++rectCount;
+				isRectSame = isRectSame && Utility::hasLineOfSight(from, rect, map) == (visible == Reference::Clear);
+			}
+
+			// Boxes of any size moved between any two points, including ones that start outside the map
+			sf::Vector2f boxFrom(unit(generator) * (width + 80.f) - 40.f, unit(generator) * (height + 80.f) - 40.f);
+			Reference clear = referenceClearance(map, boxFrom, to, size);
+			if (clear != Reference::Unsure && std::hypotf(to.x - boxFrom.x, to.y - boxFrom.y) >= 1.f)
+			{
+				++clearanceCount;
+				isClearanceSame = isClearanceSame && Utility::hasLineOfSightWithClearance(boxFrom, to, size, map) == (clear == Reference::Clear);
+			}
+		}
+		Test::check(isPointSame, where + ": a line to a point is clear exactly when no solid tile is in the way");
+		Test::check(isRectSame && rectCount > 0, where + ": a rectangle is seen exactly when a line to one of its corners is clear");
+		Test::check(isClearanceSame && clearanceCount > 0, where + ": a box moves clear exactly when it touches no solid tile and stays on the map");
+	}
+	return Test::finish();
+}
@@ -0,0 +1,176 @@
+// ================================================================================================
+// File: PlatformGraphTest.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Builds walking graphs with PlatformGraph and Navigation::findWalkingPath() and
+//              checks the paths they find, and that incremental updates match a fresh build.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <random>
+#include <string>
+#include <vector>
+#include "Check.hpp"
+#include "world/PlatformGraph.hpp"
+#include "world/Navigation.hpp"
+#include "world/TileMap.hpp"
+
+using Pathfinding::PlatformGraph;
+
+namespace
+{
+	void setSolid(TileMap& map, int x, int y, bool isSolid)
+	{
+		map.setTile(x, y, Tile{ isSolid ? Tile::Type::Solid : Tile::Type::EMPTY });
+	}
+
+	bool areGraphsEqual(const PlatformGraph& a, const PlatformGraph& b, int width, int height)
+	{
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				if (a.isNode({ x, y }) != b.isNode({ x, y }))
+					return false;
+
+				const std::vector<PlatformGraph::Link>& linksA = a.getLinks({ x, y });
+				const std::vector<PlatformGraph::Link>& linksB = b.getLinks({ x, y });
+				if (linksA.size() != linksB.size())
+					return false;
+				for (std::size_t i = 0; i < linksA.size(); ++i)
+				{
+					if (linksA[i].target != linksB[i].target || linksA[i].cost != linksB[i].cost || linksA[i].type != linksB[i].type)
+						return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	// True if every step of `path` follows a link of the graph, from the surface below `start`
+	//  to the surface below `goal`
+	bool isPathLinked(const PlatformGraph& graph, int width, sf::Vector2i start, sf::Vector2i goal, const std::vector<PlatformGraph::Step>& path)
+	{
+		sf::Vector2i current;
+		sf::Vector2i goalNode;
+		if (!graph.findSurfaceNode(start, current) || !graph.findSurfaceNode(goal, goalNode))
+			return false;
+
+		for (const PlatformGraph::Step& step : path)
+		{
+			bool isLinked = false;
+			for (const PlatformGraph::Link& link : graph.getLinks(current))
+				isLinked = isLinked || (link.target == step.tile.y * width + step.tile.x && link.type == step.type);
+			if (!isLinked)
+				return false;
+			current = step.tile;
+		}
+		return current == goalNode;
+	}
+}
+
+int main()
+{
+	// A floor with a ledge two tiles up on the right. Jumps clear one tile above the higher end,
+	//  so only a walker that can jump three tiles gets onto it, but anyone on it can drop back down
+	{
+		const int width = 12;
+		const int height = 8;
+		TileMap map(width, height);
+		for (int x = 0; x < width; ++x)
+			setSolid(map, x, height - 1, true);
+		for (int x = 8; x < width; ++x)
+			setSolid(map, x, height - 3, true);
+
+		const sf::Vector2i floorTile(1, height - 2);
+		const sf::Vector2i ledgeTile(10, height - 4);
+
+		Pathfinding::JumpProfile weakJumper;
+		weakJumper.maxJumpHeight = 2;
+		weakJumper.maxJumpDistance = 3;
+		Pathfinding::JumpProfile strongJumper = weakJumper;
+		strongJumper.maxJumpHeight = 3;
+
+		std::vector<PlatformGraph::Step> path;
+		Navigation navigation;
+		Test::check(!navigation.findWalkingPath(map, weakJumper, floorTile, ledgeTile, path), "a two tile jump does not reach a ledge two tiles up");
+		Test::check(path.empty(), "a failed search leaves the path empty");
+		Test::check(navigation.findWalkingPath(map, weakJumper, ledgeTile, floorTile, path), "anyone can drop off the ledge");
+
+		bool isFound = navigation.findWalkingPath(map, strongJumper, floorTile, ledgeTile, path);
+		Test::check(isFound, "a three tile jump reaches the ledge");
+
+		PlatformGraph graph(strongJumper);
+		graph.update(map);
+		Test::check(isFound && isPathLinked(graph, width, floorTile, ledgeTile, path), "the path to the ledge follows the graph's links");
+
+		bool isJumping = false;
+		for (const PlatformGraph::Step& step : path)
+			isJumping = isJumping || step.type == PlatformGraph::LinkType::Jump;
+		Test::check(isJumping, "the path to the ledge jumps");
+
+		// Mid-air endpoints are moved down onto the surface below them
+		Test::check(graph.findPath(sf::Vector2i(2, 0), ledgeTile, path), "a start in mid-air falls onto the floor first");
+
+		// Walling the ledge off from below leaves it out of reach again
+		for (int y = height - 6; y < height - 1; ++y)
+			setSolid(map, 7, y, true);
+		Test::check(!navigation.findWalkingPath(map, strongJumper, floorTile, ledgeTile, path), "the graph follows map changes");
+	}
+
+	// Random platform maps: the graph kept up to date through the change log must match a
+	//  fresh build, and every path found must follow its links
+	std::mt19937 generator(2);
+	for (int mapIndex = 0; mapIndex < 10; ++mapIndex)
+	{
+		const int width = 30 + static_cast<int>(generator() % 40);
+		const int height = 20 + static_cast<int>(generator() % 20);
+		auto randomTile = [&]() { return sf::Vector2i(static_cast<int>(generator() % width), static_cast<int>(generator() % height)); };
+
+		TileMap map(width, height);
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				// Sparse platforms every fourth row over a solid floor
+				if (y == height - 1 || static_cast<int>(generator() % 100) < (y % 4 == 0 ? 40 : 5))
+					setSolid(map, x, y, true);
+			}
+		}
+
+		Pathfinding::JumpProfile profile;
+		profile.height = 1 + static_cast<int>(generator() % 2);
+		profile.maxJumpHeight = static_cast<int>(generator() % 4);
+		profile.maxJumpDistance = 1 + static_cast<int>(generator() % 4);
+		PlatformGraph graph(profile);
+		graph.update(map);
+
+		for (int round = 0; round < 15; ++round)
+		{
+			int changeCount = 1 + static_cast<int>(generator() % 4);
+			for (int i = 0; i < changeCount; ++i)
+			{
+				sf::Vector2i tile = randomTile();
+				setSolid(map, tile.x, tile.y, !map.isSolid(tile));
+			}
+			graph.update(map);
+
+			std::string where = "map " + std::to_string(mapIndex) + " round " + std::to_string(round);
+			PlatformGraph freshGraph(profile);
+			freshGraph.update(map);
+			Test::check(areGraphsEqual(graph, freshGraph, width, height), where + ": the updated graph matches a fresh build");
+
+			for (int query = 0; query < 10; ++query)
+			{
+				sf::Vector2i start = randomTile();
+				sf::Vector2i goal = randomTile();
+				std::vector<PlatformGraph::Step> path;
+				if (graph.findPath(start, goal, path))
+					Test::check(isPathLinked(graph, width, start, goal, path), where + ": the path follows the graph's links");
+			}
+		}
+	}
+	return Test::finish();
+}
@@ -0,0 +1,45 @@
+// ================================================================================================
+// File: RandomMap.hpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Builds the random maps the tests run their checks on.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#pragma once
+
+#include <random>
+#include <SFML/System/Vector2.hpp>
+#include "world/TileMap.hpp"
+
+namespace Test
+{
+	// A map between `minSize` and `minSize + sizeRange - 1` tiles on each axis, with a density drawn
+	//  below `maxDensity` percent, and each tile solid with that chance. Built as one batch of edits.
+	inline TileMap makeRandomMap(std::mt19937& generator, sf::Vector2i minSize, sf::Vector2i sizeRange, int maxDensity)
+	{
+		const int width = minSize.x + static_cast<int>(generator() % sizeRange.x);
+		const int height = minSize.y + static_cast<int>(generator() % sizeRange.y);
+		const int density = static_cast<int>(generator() % maxDensity);
+
+		TileMap map(width, height);
+		map.beginEdit();
+		for (int y = 0; y < height; ++y)
+		{
+			for (int x = 0; x < width; ++x)
+			{
+				if (static_cast<int>(generator() % 100) < density)
+					map.setTile(x, y, Tile{ Tile::Type::Solid });
+			}
+		}
+		map.endEdit();
+		return map;
+	}
+
+	inline sf::Vector2i randomTile(std::mt19937& generator, const TileMap& map)
+	{
+		return sf::Vector2i(static_cast<int>(generator() % map.getWidth()), static_cast<int>(generator() % map.getHeight()));
+	}
+}
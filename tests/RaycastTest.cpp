@@ -0,0 +1,161 @@
+// ================================================================================================
+// File: RaycastTest.cpp
+// Author: agent (agent@local)
+// Created: October 17, 2026
+// Description: Checks TileMap::raycast() and TileMap::sweepBox() on hand-made cases, and that
+//              a ray or box moved between two free points is blocked or not whichever end it
+//              starts from.
+// ================================================================================================
+// License: MIT License
+// Copyright (c) 2026 agent
+// ================================================================================================
+
+#include <cmath>
+#include <random>
+#include <string>
+#include <vector>
+#include "Check.hpp"
+#include "RandomMap.hpp"
+#include "world/TileMap.hpp"
+
+namespace
+{
+	constexpr float TILE = TileMap::TILE_SIZE;
+
+	void setType(TileMap& map, int x, int y, Tile::Type type)
+	{
+		map.setTile(x, y, Tile{ type });
+	}
+
+	sf::Vector2f tileCenter(int x, int y)
+	{
+		return sf::Vector2f((x + 0.5f) * TILE, (y + 0.5f) * TILE);
+	}
+
+	bool isNear(float a, float b)
+	{
+		return std::fabs(a - b) < 0.01f;
+	}
+
+	bool isFree(const TileMap& map, sf::Vector2f point)
+	{
+		return !map.isSolid(static_cast<int>(std::floor(point.x / TILE)), static_cast<int>(std::floor(point.y / TILE)));
+	}
+
+	// Casts from `from` to `to` and back, returns true if both agree on whether something is in the way
+	bool isRaySymmetric(const TileMap& map, sf::Vector2f from, sf::Vector2f to)
+	{
+		float distance = std::hypotf(to.x - from.x, to.y - from.y);
+		TileMap::RaycastHit forward;
+		TileMap::RaycastHit backward;
+		map.raycast(from, to - from, distance, forward);
+		map.raycast(to, from - to, distance, backward);
+		return forward.isHit == backward.isHit;
+	}
+}
+
+int main()
+{
+	// A wall in column 5, with a door in it on row 1
+	{
+		TileMap map(10, 5);
+		for (int y = 0; y < 5; ++y)
+			setType(map, 5, y, y == 1 ? Tile::Type::Door : Tile::Type::Solid);
+
+		TileMap::RaycastHit hit;
+		Test::check(map.raycast(tileCenter(1, 2), { 1.f, 0.f }, 1000.f, hit), "a ray towards the wall hits it");
+		Test::check(hit.tile == sf::Vector2i(5, 2) && isNear(hit.distance, 5 * TILE - 1.5f * TILE), "the ray stops at the wall's face");
+		Test::check(isNear(hit.point.x, 5 * TILE) && hit.normal == sf::Vector2f(-1.f, 0.f), "the hit point and normal are on the face the ray entered");
+		Test::check(!map.raycast(tileCenter(1, 2), { 1.f, 0.f }, 100.f, hit), "a ray shorter than the gap does not reach the wall");
+		Test::check(!map.raycast(tileCenter(1, 2), { -1.f, 0.f }, 1000.f, hit), "a ray leaving the map hits nothing outside it");
+
+		Test::check(map.raycast(tileCenter(5, 3), { 0.f, 1.f }, 1000.f, hit) && hit.distance == 0.f && hit.normal == sf::Vector2f(0.f, 0.f),
+			"a ray starting inside a solid tile hits it at distance 0");
+
+		Test::check(!map.raycast(tileCenter(1, 1), { 1.f, 0.f }, 1000.f, hit), "solid tiles alone do not stop at a door");
+		Test::check(map.raycast(tileCenter(1, 1), { 1.f, 0.f }, 1000.f, hit, TileMap::SOLID_TILE_MASK | TileMap::getTileMask(Tile::Type::Door)) &&
+			hit.tile == sf::Vector2i(5, 1), "a door stops the ray when its type is in the mask");
+
+		TileMap::RaycastHit sweep;
+		sf::FloatRect box({ 1.5f * TILE, 2.f * TILE }, { 32.f, 32.f });
+		Test::check(map.sweepBox(box, { 1.f, 0.f }, 1000.f, sweep) && isNear(sweep.point.x + 32.f, 5 * TILE), "a swept box stops touching the wall");
+		Test::check(!map.sweepBox(sf::FloatRect({ 5 * TILE - 32.f, 2.f * TILE }, { 32.f, 32.f }), { -1.f, 0.f }, 1000.f, sweep),
+			"a box touching the wall can move away from it");
+	}
+
+	// Two solid tiles meeting at a corner seal it, a single one beside the corner does not
+	{
+		TileMap map(4, 4);
+		setType(map, 2, 1, Tile::Type::Solid);
+		TileMap::RaycastHit hit;
+		Test::check(!map.raycast(tileCenter(1, 1), { 1.f, 1.f }, 2.f * TILE, hit), "a diagonal past one solid tile is clear");
+		Test::check(!map.raycast(tileCenter(2, 2), { -1.f, -1.f }, 2.f * TILE, hit), "the same diagonal is clear the other way too");
+
+		setType(map, 1, 2, Tile::Type::Solid);
+		Test::check(map.raycast(tileCenter(1, 1), { 1.f, 1.f }, 2.f * TILE, hit), "a diagonal between two solid tiles is blocked");
+		Test::check(map.raycast(tileCenter(2, 2), { -1.f, -1.f }, 2.f * TILE, hit), "the same diagonal is blocked the other way too");
+	}
+
+	// Random maps: rays between free points (anywhere, and through tile centres where they often
+	//  cross corners exactly) are blocked the same both ways, and so are boxes
+	std::mt19937 generator(3);
+	std::uniform_real_distribution<float> unit(0.f, 1.f);
+	for (int mapIndex = 0; mapIndex < 30; ++mapIndex)
+	{
+		TileMap map = Test::makeRandomMap(generator, { 10, 10 }, { 40, 30 }, 30);
+		const int width = map.getWidth();
+		const int height = map.getHeight();
+
+		std::string where = "map " + std::to_string(mapIndex);
+		auto randomPoint = [&]() { return sf::Vector2f(unit(generator) * width * TILE, unit(generator) * height * TILE); };
+		auto randomCenter = [&]() { return tileCenter(static_cast<int>(generator() % width), static_cast<int>(generator() % height)); };
+
+		bool isRaySymmetricEverywhere = true;
+		bool isRaySymmetricAtCenters = true;
+		bool isSweepSymmetric = true;
+		for (int query = 0; query < 200; ++query)
+		{
+			sf::Vector2f from = randomPoint();
+			sf::Vector2f to = randomPoint();
+			if (isFree(map, from) && isFree(map, to) && from != to)
+				isRaySymmetricEverywhere = isRaySymmetricEverywhere && isRaySymmetric(map, from, to);
+
+			sf::Vector2f fromCenter = randomCenter();
+			sf::Vector2f toCenter = randomCenter();
+			if (isFree(map, fromCenter) && isFree(map, toCenter) && fromCenter != toCenter)
+				isRaySymmetricAtCenters = isRaySymmetricAtCenters && isRaySymmetric(map, fromCenter, toCenter);
+
+			// Boxes that do not start in a solid tile at either end
+			sf::Vector2f size(5.f + unit(generator) * 100.f, 5.f + unit(generator) * 100.f);
+			sf::FloatRect fromBox(from, size);
+			sf::FloatRect toBox(to, size);
+			float distance = std::hypotf(to.x - from.x, to.y - from.y);
+			TileMap::RaycastHit forward;
+			TileMap::RaycastHit backward;
+			if (from == to || map.sweepBox(fromBox, { 1.f, 0.f }, 0.f, forward) || map.sweepBox(toBox, { 1.f, 0.f }, 0.f, backward))
+				continue;
+			map.sweepBox(fromBox, to - from, distance, forward);
+			map.sweepBox(toBox, from - to, distance, backward);
+			isSweepSymmetric = isSweepSymmetric && forward.isHit == backward.isHit;
+		}
+		Test::check(isRaySymmetricEverywhere, where + ": rays between free points are blocked the same both ways");
+		Test::check(isRaySymmetricAtCenters, where + ": rays between tile centres are blocked the same both ways");
+		Test::check(isSweepSymmetric, where + ": boxes between free positions are blocked the same both ways");
+
+		// The batched raycast gives exactly the single one's hits
+		std::vector<TileMap::Ray> rays;
+		for (int i = 0; i < 50; ++i)
+			rays.push_back({ randomPoint(), { unit(generator) - 0.5f, unit(generator) - 0.5f }, 1000.f });
+		std::vector<TileMap::RaycastHit> hits;
+		map.raycast(rays, hits);
+		bool isBatchSame = hits.size() == rays.size();
+		for (std::size_t i = 0; i < rays.size() && isBatchSame; ++i)
+		{
+			TileMap::RaycastHit single;
+			map.raycast(rays[i].origin, rays[i].direction, rays[i].maxDistance, single);
+			isBatchSame = single.isHit == hits[i].isHit && single.distance == hits[i].distance && single.tile == hits[i].tile;
+		}
+		Test::check(isBatchSame, where + ": batched rays match single ones");
+	}
+	return Test::finish();
+}